@@ -16,14 +16,52 @@
  * Included files
  **********************************************************************************************************************/
 
+/* C includes */
+#include <stdint.h>
+#include <stdbool.h>
+
 /* BSP (board support package) include */
 #include "stm32f4xx_control.h"
 
+/***********************************************************************************************************************
+ * Types declarations
+ **********************************************************************************************************************/
+
+/**
+ * @brief Módulos que deben confirmar el echo de inicio
+ *
+ */
+typedef enum
+{
+	kSTARTUP_MODULE_BMS = 0,
+	kSTARTUP_MODULE_DCDC,
+	kSTARTUP_MODULE_INVERSOR,
+	kSTARTUP_MODULE_PERIFERICOS,
+
+	kSTARTUP_MODULE_COUNT
+} startup_module_t;
+
+/**
+ * @brief Tipo de dato app_startup_stats_t para estadísticas del handshake de inicio.
+ *
+ * Los tiempos se miden desde el primer echo.
+ *
+ */
+typedef struct
+{
+	bool		ready;								/**< Todos los módulos confirmaron */
+	uint32_t	time_to_ready_ms;					/**< Tiempo hasta la confirmación del último módulo */
+	uint32_t	echoes;								/**< Echos enviados */
+	uint32_t	acked_modules;						/**< Módulos que confirmaron (un bit por startup_module_t) */
+	uint32_t	ack_ms[kSTARTUP_MODULE_COUNT];		/**< Tiempo de confirmación de cada módulo */
+} app_startup_stats_t;
+
 /***********************************************************************************************************************
  * Public function prototypes
  **********************************************************************************************************************/
 
 void MX_APP_Init(void);
 void MX_APP_Process(void);
+const app_startup_stats_t *MX_APP_Get_StartupStats(void);
 
 #endif /* _APP_CONTROL_H_ */
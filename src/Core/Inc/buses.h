@@ -53,58 +53,71 @@ typedef struct bus1
     module_status_t         dcdc_status;
     module_status_t         inversor_status;
 
+    /* Máscara de variables del bus de entrada CAN vencidas o nunca recibidas (un bit por rx_signal_t) */
+    uint32_t                stale_signals;
+
 } typedef_bus1_t;
 
+#define BUS_TX_FIELD(module, id_name, id, dir, fifo, field, type, decode, dest, scale, offset, period_ms) \
+    CAN_SIGNAL_IF_TX(dir, type field;)
+
+#define BUS_RX_FIELD(module, id_name, id, dir, fifo, field, type, decode, dest, scale, offset, period_ms) \
+    CAN_SIGNAL_IF_RX(dir, type field;)
+
+#define BUS_RX_SIGNAL(module, id_name, id, dir, fifo, field, type, decode, dest, scale, offset, period_ms) \
+    CAN_SIGNAL_IF_RX(dir, kRX_SIGNAL_##id_name,)
+
 /**
  * @brief Bus 2: bus de variables que se transmiten por CAN
  *
+ * Una variable por cada señal TX del registro de señales CAN (can_def.h).
+ *
  */
 typedef struct bus2
 {
-    uint8_t  autokill;                  /**< CAN  0x001 */
-    uint8_t  estado_manejo; 	        /**< CAN  0x010 */
-    uint8_t  estado_falla; 		        /**< CAN  0x011 */
-    uint8_t  nivel_velocidad;	        /**< CAN  0x012 */
-    uint8_t  hombre_muerto;		        /**< CAN  0x013 */
-    uint8_t  control_ok;		        /**< CAN  0x014 */
+    CAN_SIGNALS(BUS_TX_FIELD)
 
 } typedef_bus2_t;
 
 /**
  * @brief Bus 3: bus de variables que se reciben por CAN
  *
+ * Una variable por cada señal RX del registro de señales CAN (can_def.h).
+ *
  */
 typedef struct bus3
 {
-    uint8_t  pedal;						/**< CAN 0x002 */
-    uint8_t  hombre_muerto;				/**< CAN 0x003 */
-    uint8_t  botones_cambio_estado;		/**< CAN 0x004 */
-    uint8_t  perifericos_ok;			/**< CAN 0x005 */
-
-    uint8_t  voltaje_bms;				/**< CAN 0x020 */
-    uint8_t  corriente_bms;				/**< CAN 0x021 */
-    uint8_t  voltaje_min_celda_bms;		/**< CAN 0x022 */
-    uint8_t  potencia_bms;				/**< CAN 0x023 */
-    uint8_t  t_max_bms;					/**< CAN 0x024 */
-    uint8_t  nivel_bateria_bms;			/**< CAN 0x025 */
-    uint8_t  bms_ok;					/**< CAN 0x026 */
-
-    uint8_t  voltaje_bateria_dcdc;		/**< CAN 0x030 */
-    uint8_t  voltaje_salida_dcdc;       /**< CAN 0x031 */
-    uint8_t  t_max_dcdc;				/**< CAN 0x032 */
-    uint8_t  dcdc_ok;					/**< CAN 0x033 */
-    uint8_t  potencia_dcdc;             /**< CAN 0x034 */
-
-    uint8_t  velocidad_inv;				/**< CAN 0x040 */
-    uint8_t  V_inv;						/**< CAN 0x041 */
-    uint8_t  I_inv;						/**< CAN 0x042 */
-    uint8_t  temp_max_inv;				/**< CAN 0x043 */
-    uint8_t  temp_motor_inv;			/**< CAN 0x044 */
-    uint8_t  potencia_inv;				/**< CAN 0x045 */
-    uint8_t  inversor_ok;				/**< CAN 0x046 */
+    CAN_SIGNALS(BUS_RX_FIELD)
 
 } typedef_bus3_t;
 
+/**
+ * @brief Índice de cada variable del bus de recepción CAN (bit en máscara de variables actualizadas)
+ *
+ */
+typedef enum
+{
+    CAN_SIGNALS(BUS_RX_SIGNAL)
+
+    kRX_SIGNAL_COUNT
+} rx_signal_t;
+
+/** @brief Bit de una variable del bus de recepción CAN en las máscaras de variables */
+#define RX_SIGNAL_MASK(signal)          (1UL << (signal))
+
+/** @brief Máscara con todas las variables del bus de recepción CAN */
+#define RX_SIGNAL_ALL_MASK              (0xFFFFFFFFUL >> (32U - kRX_SIGNAL_COUNT))
+
+#define RX_SIGNAL_MODULE_BIT(module, id_name, id, dir, fifo, field, type, decode, dest, scale, offset, period_ms) \
+    CAN_SIGNAL_IF_RX(dir, | RX_SIGNAL_MASK(kRX_SIGNAL_##id_name))
+
+/** @brief Máscara con las variables del bus de recepción CAN de un módulo (PERIFERICOS, BMS, DCDC o INVERSOR) */
+#define RX_MODULE_SIGNALS_MASK(module)  (0UL CAN_SIGNALS_##module(RX_SIGNAL_MODULE_BIT))
+
+#undef BUS_TX_FIELD
+#undef BUS_RX_FIELD
+#undef BUS_RX_SIGNAL
+
 /***********************************************************************************************************************
  * Global variables declarations
  **********************************************************************************************************************/
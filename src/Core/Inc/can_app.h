@@ -17,12 +17,17 @@
  * Included files
  **********************************************************************************************************************/
 
+/* C includes */
+#include <stddef.h>
+#include <string.h>
+
 /* CAN driver include */
 #include "can_api.h"
 
 /* CAN application includes */
 #include "can_hw.h"
 #include "can_def.h"
+#include "can_tx.h"
 
 /* Application includes */
 #include "decode_data.h"
@@ -42,8 +47,9 @@
  * @brief Función principal de CAN a nivel de aplicación.
  *
  * Guarda mensaje CAN recibido en bus de entrada CAN cuando se activa
- * bandera de recepción. Envía datos de bus de salida CAN cuando se
- * activa bandera de transmisión.
+ * bandera de recepción. Transmite los cambios del bus de salida CAN y
+ * sus heartbeats, y en cada slot de transmisión (TIM7) los frames de
+ * diagnóstico.
  *
  * No es static, por lo que puede ser usada por otros archivos.
  *
@@ -55,7 +61,8 @@ void CAN_APP_Process(void);
 /**
  * @brief Función de envío de datos de bus de salida CAN a módulo CAN.
  *
- * Realiza el envío de las variables que se encuentran en el bus de salida CAN a módulo CAN.
+ * Realiza el envío inmediato de todos los frames de salida (fuera del planificador de
+ * transmisión), por ejemplo para el eco de inicio.
  *
  * No es static, por lo que puede ser usada por otros archivos.
  *
@@ -64,6 +71,18 @@ void CAN_APP_Process(void);
  */
 void CAN_APP_Send_BusData(typedef_bus2_t *bus_can_output);
 
+/**
+ * @brief Función de recepción de todos los mensajes CAN pendientes.
+ *
+ * Vacía el buffer de recepción CAN, guardando cada mensaje en el bus de entrada CAN.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param None
+ * @return uint32_t Número de mensajes procesados
+ */
+uint32_t CAN_APP_Receive_Messages(void);
+
 /**
  * @brief Función guardar mensaje CAN recibido en bus de entrada CAN.
  *
@@ -72,9 +91,27 @@ void CAN_APP_Send_BusData(typedef_bus2_t *bus_can_output);
  *
  * No es static, por lo que puede ser usada por otros archivos.
  *
- * @param None
+ * @param frame Puntero a mensaje CAN recibido
  * @retval None
  */
-void CAN_APP_Store_ReceivedMessage(void);
+void CAN_APP_Store_ReceivedMessage(const can_frame_t *frame);
+
+/**
+ * @brief Tiempo de recepción del último frame que cambió alguna de las variables indicadas.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param signals Máscara de variables del bus de entrada CAN (un bit por rx_signal_t)
+ * @return uint32_t Tiempo [us] (TIMEBASE_Get_TimeUs) del cambio más reciente, o el tiempo actual
+ *                  si ninguna de las variables ha cambiado
+ */
+uint32_t CAN_APP_Get_SignalChangeUs(uint32_t signals);
+
+/***********************************************************************************************************************
+ * Global variables declarations
+ **********************************************************************************************************************/
+
+/** @brief Máscara de variables del bus de entrada CAN con valor nuevo, pendientes de decodificar (un bit por rx_signal_t) */
+extern uint32_t can_rx_dirty_signals;
 
 #endif /* _CAN_APP_H_ */
@@ -12,57 +12,377 @@
 #ifndef _CAN_DEF_H_
 #define _CAN_DEF_H_
 
+/***********************************************************************************************************************
+ * Included files
+ **********************************************************************************************************************/
+
+/* STM32 HAL include (PROFILING_ENABLED) */
+#include "main.h"
+
 /***********************************************************************************************************************
  * Macros
  **********************************************************************************************************************/
 
 /********************************************************************************
- *                                  CAN IDs                                     *
+ *                    Pedal y velocidad de alta resolución                      *
+ *******************************************************************************/
+
+/*
+ * Con CAN_HIGH_RES_PEDAL en 1, el pedal (PERIFERICOS_PEDAL) y el nivel de velocidad
+ * (CONTROL_NIVEL_VELOCIDAD) viajan en frames de 2 bytes little-endian, en punto fijo con
+ * CAN_PEDAL_FRAC_BITS bits fraccionarios: [0:100] con resolución de 1/256. Periféricos
+ * escala su lectura (p. ej. un ADC de 12 bits) a este formato. Con 0 viajan en frames de
+ * 1 byte, en enteros [0:100].
+ *
+ * Los frames de 2 bytes no son compatibles con el modo empaquetado de Control ni de
+ * Periféricos (un byte por señal).
+ */
+#define CAN_HIGH_RES_PEDAL                          0
+
+#if CAN_HIGH_RES_PEDAL == 1
+#define CAN_PEDAL_TYPE                              uint16_t
+#define CAN_PEDAL_FRAC_BITS                         8U
+#else
+#define CAN_PEDAL_TYPE                              uint8_t
+#define CAN_PEDAL_FRAC_BITS                         0U
+#endif /* CAN_HIGH_RES_PEDAL */
+
+/** @brief Escala de pedal y nivel de velocidad en CAN a [0:100] */
+#define CAN_PEDAL_SCALE                             (1.0f / (float)(1UL << CAN_PEDAL_FRAC_BITS))
+
+/********************************************************************************
+ *                           Registro de señales CAN                            *
  *******************************************************************************/
 
+/*
+ * Registro único de señales CAN. Cada señal se declara en una sola línea, y a partir
+ * de este registro se generan en tiempo de compilación:
+ *
+ *  - Los IDs CAN_ID_<id_name> (can_def.h)
+ *  - Las variables de bus_can_input y bus_can_output (buses.h)
+ *  - La tabla de despacho de recepción (can_app.c)
+ *  - Las rutinas de decodificación de cada módulo (decode_data.c)
+ *  - Los filtros de hardware CAN (can_wrapper.c)
+ *
+ * X(module, id_name, id, dir, fifo, field, type, decode, dest, scale, offset, period_ms)
+ *
+ *  module      Módulo que transmite la señal
+ *  id_name     Nombre del ID, se genera CAN_ID_<id_name>
+ *  id          Standard identifier
+ *  dir         RX (se recibe, va en bus_can_input) o TX (se transmite, va en bus_can_output)
+ *  fifo        FIFO de recepción: 1 para mensajes de latencia crítica, 0 para el resto
+ *  field       Variable en bus_can_input o bus_can_output
+ *  type        Tipo de la variable (define el ancho del payload)
+ *  decode      Tipo de decodificación: ANALOG, MODULE_INFO, BTN, HOMBRE_MUERTO o NONE
+ *  dest        Variable decodificada en bus_data (NONE si no se decodifica)
+ *  scale       Escala de la decodificación analógica: dest = field * scale + offset
+ *  offset      Offset de la decodificación analógica
+ *  period_ms   Periodo esperado de la señal en ms (TX: máximo silencio, ver CAN_TX_SCHEDULE)
+ */
+
 /* ================================ Control ================================== */
 
-#define CAN_ID_CONTROL_AUTOKILL                 	0x001
-#define CAN_ID_CONTROL_ESTADO_MANEJO 		    	0x010
-#define CAN_ID_CONTROL_ESTADO_FALLA			    	0x011
-#define CAN_ID_CONTROL_NIVEL_VELOCIDAD		    	0x012
-#define CAN_ID_CONTROL_HOMBRE_MUERTO		    	0x013
-#define CAN_ID_CONTROL_OK			    			0x014
+#define CAN_SIGNALS_CONTROL(X) \
+    X(CONTROL,      CONTROL_AUTOKILL,                   0x001,  TX, 0,  autokill,               uint8_t, NONE,          NONE,                                   1.0f, 0.0f, 100)  \
+    X(CONTROL,      CONTROL_ESTADO_MANEJO,              0x010,  TX, 0,  estado_manejo,          uint8_t, NONE,          NONE,                                   1.0f, 0.0f, 100)  \
+    X(CONTROL,      CONTROL_ESTADO_FALLA,               0x011,  TX, 0,  estado_falla,           uint8_t, NONE,          NONE,                                   1.0f, 0.0f, 100)  \
+    X(CONTROL,      CONTROL_NIVEL_VELOCIDAD,            0x012,  TX, 0,  nivel_velocidad,        CAN_PEDAL_TYPE, NONE,   NONE,                                   1.0f, 0.0f, 100)  \
+    X(CONTROL,      CONTROL_HOMBRE_MUERTO,              0x013,  TX, 0,  hombre_muerto,          uint8_t, NONE,          NONE,                                   1.0f, 0.0f, 100)  \
+    X(CONTROL,      CONTROL_OK,                         0x014,  TX, 0,  control_ok,             uint8_t, NONE,          NONE,                                   1.0f, 0.0f, 500)
 
 /* =============================== Perifericos =============================== */
 
-#define CAN_ID_PERIFERICOS_PEDAL					0x002
-#define CAN_ID_PERIFERICOS_HOMBRE_MUERTO			0x003
-#define CAN_ID_PERIFERICOS_BOTONES_CAMBIO_ESTADO	0x004
-#define CAN_ID_PERIFERICOS_OK						0x005
+#define CAN_SIGNALS_PERIFERICOS(X) \
+    X(PERIFERICOS,  PERIFERICOS_PEDAL,                  0x002,  RX, 1,  pedal,                  CAN_PEDAL_TYPE, ANALOG, Rx_Peripherals.pedal,                   CAN_PEDAL_SCALE, 0.0f, 20)   \
+    X(PERIFERICOS,  PERIFERICOS_HOMBRE_MUERTO,          0x003,  RX, 1,  hombre_muerto,          uint8_t, HOMBRE_MUERTO, Rx_Peripherals.hombre_muerto,           1.0f, 0.0f, 20)   \
+    X(PERIFERICOS,  PERIFERICOS_BOTONES_CAMBIO_ESTADO,  0x004,  RX, 0,  botones_cambio_estado,  uint8_t, BTN,           Rx_Peripherals.botones_cambio_estado,   1.0f, 0.0f, 100)  \
+    X(PERIFERICOS,  PERIFERICOS_OK,                     0x005,  RX, 1,  perifericos_ok,         uint8_t, MODULE_INFO,   Rx_Peripherals.perifericos_ok,          1.0f, 0.0f, 500)
 
 /* ================================== BMS ==================================== */
 
-#define CAN_ID_BMS_VOLTAJE							0x020
-#define	CAN_ID_BMS_CORRIENTE						0x021
-#define CAN_ID_BMS_VOLTAJE_MIN_CELDA 				0x022
-#define CAN_ID_BMS_POTENCIA             			0x023
-#define CAN_ID_BMS_T_MAX							0x024
-#define	CAN_ID_BMS_NIVEL_BATERIA					0x025
-#define CAN_ID_BMS_OK								0x026
+#define CAN_SIGNALS_BMS(X) \
+    X(BMS,          BMS_VOLTAJE,                        0x020,  RX, 0,  voltaje_bms,            uint8_t, ANALOG,        Rx_Bms.voltaje,                         1.0f, 0.0f, 100)  \
+    X(BMS,          BMS_CORRIENTE,                      0x021,  RX, 0,  corriente_bms,          uint8_t, ANALOG,        Rx_Bms.corriente,                       1.0f, 0.0f, 100)  \
+    X(BMS,          BMS_VOLTAJE_MIN_CELDA,              0x022,  RX, 0,  voltaje_min_celda_bms,  uint8_t, ANALOG,        Rx_Bms.voltaje_min_celda,               1.0f, 0.0f, 100)  \
+    X(BMS,          BMS_POTENCIA,                       0x023,  RX, 0,  potencia_bms,           uint8_t, ANALOG,        Rx_Bms.potencia,                        1.0f, 0.0f, 100)  \
+    X(BMS,          BMS_T_MAX,                          0x024,  RX, 0,  t_max_bms,              uint8_t, ANALOG,        Rx_Bms.t_max,                           1.0f, 0.0f, 100)  \
+    X(BMS,          BMS_NIVEL_BATERIA,                  0x025,  RX, 0,  nivel_bateria_bms,      uint8_t, ANALOG,        Rx_Bms.nivel_bateria,                   1.0f, 0.0f, 100)  \
+    X(BMS,          BMS_OK,                             0x026,  RX, 1,  bms_ok,                 uint8_t, MODULE_INFO,   Rx_Bms.bms_ok,                          1.0f, 0.0f, 500)
 
 /* ================================== DCDC =================================== */
 
-#define CAN_ID_DCDC_VOLTAJE_BATERIA					0x030
-#define CAN_ID_DCDC_VOLTAJE_SALIDA      			0x031
-#define CAN_ID_DCDC_T_MAX							0x032
-#define CAN_ID_DCDC_OK								0x033
-#define CAN_ID_DCDC_POTENCIA            			0x034
+#define CAN_SIGNALS_DCDC(X) \
+    X(DCDC,         DCDC_VOLTAJE_BATERIA,               0x030,  RX, 0,  voltaje_bateria_dcdc,   uint8_t, ANALOG,        Rx_Dcdc.voltaje_bateria,                1.0f, 0.0f, 100)  \
+    X(DCDC,         DCDC_VOLTAJE_SALIDA,                0x031,  RX, 0,  voltaje_salida_dcdc,    uint8_t, ANALOG,        Rx_Dcdc.voltaje_salida,                 1.0f, 0.0f, 100)  \
+    X(DCDC,         DCDC_T_MAX,                         0x032,  RX, 0,  t_max_dcdc,             uint8_t, ANALOG,        Rx_Dcdc.t_max,                          1.0f, 0.0f, 100)  \
+    X(DCDC,         DCDC_OK,                            0x033,  RX, 1,  dcdc_ok,                uint8_t, MODULE_INFO,   Rx_Dcdc.dcdc_ok,                        1.0f, 0.0f, 500)  \
+    X(DCDC,         DCDC_POTENCIA,                      0x034,  RX, 0,  potencia_dcdc,          uint8_t, ANALOG,        Rx_Dcdc.potencia,                       1.0f, 0.0f, 100)
 
 /* ================================ Inversor ================================= */
 
-#define CAN_ID_INVERSOR_VELOCIDAD					0x040
-#define CAN_ID_INVERSOR_V							0x041
-#define CAN_ID_INVERSOR_I							0x042
-#define CAN_ID_INVERSOR_TEMP_MAX					0x043
-#define CAN_ID_INVERSOR_TEMP_MOTOR					0x044
-#define CAN_ID_INVERSOR_POTENCIA					0x045
-#define CAN_ID_INVERSOR_OK							0x046
+#define CAN_SIGNALS_INVERSOR(X) \
+    X(INVERSOR,     INVERSOR_VELOCIDAD,                 0x040,  RX, 0,  velocidad_inv,          uint8_t, ANALOG,        Rx_Inversor.velocidad,                  1.0f, 0.0f, 100)  \
+    X(INVERSOR,     INVERSOR_V,                         0x041,  RX, 0,  V_inv,                  uint8_t, ANALOG,        Rx_Inversor.V,                          1.0f, 0.0f, 100)  \
+    X(INVERSOR,     INVERSOR_I,                         0x042,  RX, 0,  I_inv,                  uint8_t, ANALOG,        Rx_Inversor.I,                          1.0f, 0.0f, 100)  \
+    X(INVERSOR,     INVERSOR_TEMP_MAX,                  0x043,  RX, 0,  temp_max_inv,           uint8_t, ANALOG,        Rx_Inversor.temp_max,                   1.0f, 0.0f, 100)  \
+    X(INVERSOR,     INVERSOR_TEMP_MOTOR,                0x044,  RX, 0,  temp_motor_inv,         uint8_t, ANALOG,        Rx_Inversor.temp_motor,                 1.0f, 0.0f, 100)  \
+    X(INVERSOR,     INVERSOR_POTENCIA,                  0x045,  RX, 0,  potencia_inv,           uint8_t, ANALOG,        Rx_Inversor.potencia,                   1.0f, 0.0f, 100)  \
+    X(INVERSOR,     INVERSOR_OK,                        0x046,  RX, 1,  inversor_ok,            uint8_t, MODULE_INFO,   Rx_Inversor.inversor_ok,                1.0f, 0.0f, 500)
+
+/* ========================== Todas las señales CAN ========================== */
+
+#define CAN_SIGNALS(X) \
+    CAN_SIGNALS_CONTROL(X) \
+    CAN_SIGNALS_PERIFERICOS(X) \
+    CAN_SIGNALS_BMS(X) \
+    CAN_SIGNALS_DCDC(X) \
+    CAN_SIGNALS_INVERSOR(X)
+
+/*
+ * Helpers para expandir el registro solo para señales RX o solo para señales TX.
+ * CAN_SIGNAL_IF_RX(dir, ...) expande a sus argumentos solo si dir es RX (y análogo para TX).
+ */
+#define CAN_SIGNAL_RX_ONLY_RX(...)      __VA_ARGS__
+#define CAN_SIGNAL_RX_ONLY_TX(...)
+#define CAN_SIGNAL_TX_ONLY_RX(...)
+#define CAN_SIGNAL_TX_ONLY_TX(...)      __VA_ARGS__
+
+#define CAN_SIGNAL_IF_RX(dir, ...)      CAN_SIGNAL_RX_ONLY_##dir(__VA_ARGS__)
+#define CAN_SIGNAL_IF_TX(dir, ...)      CAN_SIGNAL_TX_ONLY_##dir(__VA_ARGS__)
+
+/********************************************************************************
+ *                           Frames empaquetados                                *
+ *******************************************************************************/
+
+/*
+ * En modo empaquetado, todas las señales de un módulo viajan en un solo frame de hasta
+ * 8 bytes: el byte i del payload es la i-ésima señal del módulo en el registro de señales
+ * (las variables del módulo quedan contiguas en bus_can_input y bus_can_output, en ese
+ * mismo orden). En modo legacy, cada señal viaja en su propio frame de 1 byte.
+ *
+ * El modo se selecciona por módulo, de modo que los nodos que aún transmiten frames de
+ * 1 byte se siguen decodificando. Para un módulo en modo empaquetado solo se aceptan
+ * (filtros y despacho) su frame empaquetado, y no sus IDs legacy.
+ *
+ * Comparación de carga de bus a 250 kbit/s (4 us/bit). Frame estándar sin bit stuffing:
+ * 47 bits de overhead + 8 bits por byte de datos.
+ *
+ *  Módulo        Legacy (n frames de 1 byte)     Empaquetado (1 frame de n bytes)
+ *  Control       6 x 55 = 330 bits (1320 us)      47 + 48 =  95 bits (380 us)
+ *  Perifericos   4 x 55 = 220 bits ( 880 us)      47 + 32 =  79 bits (316 us)
+ *  BMS           7 x 55 = 385 bits (1540 us)      47 + 56 = 103 bits (412 us)
+ *  DCDC          5 x 55 = 275 bits (1100 us)      47 + 40 =  87 bits (348 us)
+ *  Inversor      7 x 55 = 385 bits (1540 us)      47 + 56 = 103 bits (412 us)
+ *  Total        1595 bits (6380 us)               467 bits (1868 us)
+ *
+ * Con una actualización completa de todas las señales cada 100 ms, la carga de bus pasa
+ * de 6.4 % (legacy) a 1.9 % (empaquetado); cada 20 ms, de 31.9 % a 9.3 %.
+ */
+
+/** @brief Modo de frames por módulo: 0 = legacy (1 byte por frame), 1 = empaquetado */
+#define CAN_PACKED_FRAME_CONTROL                    0
+#define CAN_PACKED_FRAME_PERIFERICOS                0
+#define CAN_PACKED_FRAME_BMS                        0
+#define CAN_PACKED_FRAME_DCDC                       0
+#define CAN_PACKED_FRAME_INVERSOR                   0
+
+/*
+ * X(module, id_name, id, dir, fifo, first_id_name, first_field)
+ *
+ *  first_id_name   Nombre del ID de la primera señal del módulo (byte 0 del payload)
+ *  first_field     Variable de la primera señal del módulo en bus_can_input o bus_can_output
+ */
+#define CAN_PACKED_FRAMES(X) \
+    X(CONTROL,      CONTROL_PACKED,                     0x015,  TX, 0,  CONTROL_AUTOKILL,       autokill)               \
+    X(PERIFERICOS,  PERIFERICOS_PACKED,                 0x006,  RX, 1,  PERIFERICOS_PEDAL,      pedal)                  \
+    X(BMS,          BMS_PACKED,                         0x027,  RX, 0,  BMS_VOLTAJE,            voltaje_bms)            \
+    X(DCDC,         DCDC_PACKED,                        0x035,  RX, 0,  DCDC_VOLTAJE_BATERIA,   voltaje_bateria_dcdc)   \
+    X(INVERSOR,     INVERSOR_PACKED,                    0x047,  RX, 0,  INVERSOR_VELOCIDAD,     velocidad_inv)
+
+/*
+ * Helpers para expandir el registro según el modo de frames del módulo.
+ * CAN_SIGNAL_IF_LEGACY(module, ...) expande a sus argumentos solo si el módulo está en modo legacy,
+ * y CAN_SIGNAL_IF_PACKED(module, ...) solo si está en modo empaquetado.
+ */
+#define CAN_DEF_CAT(a, b)               CAN_DEF_CAT_(a, b)
+#define CAN_DEF_CAT_(a, b)              a##b
+
+#define CAN_SIGNAL_LEGACY_ONLY_0(...)   __VA_ARGS__
+#define CAN_SIGNAL_LEGACY_ONLY_1(...)
+#define CAN_SIGNAL_PACKED_ONLY_0(...)
+#define CAN_SIGNAL_PACKED_ONLY_1(...)   __VA_ARGS__
+
+#define CAN_SIGNAL_IF_LEGACY(module, ...)   CAN_DEF_CAT(CAN_SIGNAL_LEGACY_ONLY_, CAN_PACKED_FRAME_##module)(__VA_ARGS__)
+#define CAN_SIGNAL_IF_PACKED(module, ...)   CAN_DEF_CAT(CAN_SIGNAL_PACKED_ONLY_, CAN_PACKED_FRAME_##module)(__VA_ARGS__)
+
+/** @brief Número de señales de un módulo (en una dirección), como expresión constante */
+#define CAN_DEF_COUNT_RX(module, id_name, id, dir, fifo, field, type, decode, dest, scale, offset, period_ms) \
+    CAN_SIGNAL_IF_RX(dir, + 1)
+#define CAN_DEF_COUNT_TX(module, id_name, id, dir, fifo, field, type, decode, dest, scale, offset, period_ms) \
+    CAN_SIGNAL_IF_TX(dir, + 1)
+
+#define CAN_MODULE_NUM_OF_SIGNALS(module, dir)  (0 CAN_SIGNALS_##module(CAN_DEF_COUNT_##dir))
+
+/** @brief Bytes de las variables de un módulo (en una dirección), como expresión constante */
+#define CAN_DEF_SIZE_RX(module, id_name, id, dir, fifo, field, type, decode, dest, scale, offset, period_ms) \
+    CAN_SIGNAL_IF_RX(dir, + sizeof(type))
+#define CAN_DEF_SIZE_TX(module, id_name, id, dir, fifo, field, type, decode, dest, scale, offset, period_ms) \
+    CAN_SIGNAL_IF_TX(dir, + sizeof(type))
+
+#define CAN_MODULE_SIZE(module, dir)            (0 CAN_SIGNALS_##module(CAN_DEF_SIZE_##dir))
+
+/********************************************************************************
+ *                       Planificación de transmisión                           *
+ *******************************************************************************/
+
+/*
+ * Cada frame de salida se transmite en cuanto cambia su valor, con un intervalo mínimo
+ * entre transmisiones (min_gap_ms) para no saturar el bus con una señal que cambia muy
+ * seguido; un cambio dentro del intervalo mínimo se transmite al terminar el intervalo.
+ * Si el valor no cambia, el frame se repite como heartbeat cuando pasa su máximo silencio
+ * (period_ms del registro de señales, o CAN_TX_PACKED_PERIOD_MS para el frame empaquetado).
+ * Los desfases reparten los primeros heartbeats entre slots para evitar ráfagas.
+ *
+ * X(id_name, offset_ms, min_gap_ms)
+ *
+ *  id_name     Nombre del ID de una señal TX o de un frame empaquetado TX
+ *  offset_ms   Desfase [ms] del primer heartbeat
+ *  min_gap_ms  Intervalo mínimo [ms] entre transmisiones por cambio de valor
+ */
+#define CAN_TX_SCHEDULE(X) \
+    X(CONTROL_AUTOKILL,                                 0,      0)  \
+    X(CONTROL_ESTADO_MANEJO,                            30,     10) \
+    X(CONTROL_ESTADO_FALLA,                             60,     10) \
+    X(CONTROL_NIVEL_VELOCIDAD,                          10,     20) \
+    X(CONTROL_HOMBRE_MUERTO,                            20,     0)  \
+    X(CONTROL_OK,                                       90,     10) \
+    X(CONTROL_PACKED,                                   0,      10)
+
+/** @brief Máximo silencio [ms] del frame empaquetado de Control (heartbeat) */
+#define CAN_TX_PACKED_PERIOD_MS                     100
+
+/********************************************************************************
+ *                           Frames de diagnóstico                              *
+ *******************************************************************************/
+
+/*
+ * Frames de diagnóstico transmitidos por Control, fuera del bus de salida CAN.
+ *
+ * X(id_name, id, period_ms)
+ *
+ * CONTROL_DIAG_CAN: estado de errores del periférico CAN. Los contadores saturan en 255.
+ *  Byte 0  TEC (transmit error counter)
+ *  Byte 1  REC (receive error counter)
+ *  Byte 2  Estado de error: bit 0 error warning, bit 1 error passive, bit 2 bus-off,
+ *          bits 4-6 último código de error de protocolo (LEC)
+ *  Byte 3  Entradas a bus-off
+ *  Byte 4  Entradas a error passive
+ *  Byte 5  Errores de protocolo
+ *  Byte 6  Mensajes perdidos por overrun de FIFO de hardware y de buffer de recepción
+ *  Byte 7  Mensajes no transmitidos (descartados por cola de transmisión llena)
+ *
+ * CONTROL_DIAG_CAN_TX: estado de la cola de transmisión CAN. Valores de 16 bits little-endian,
+ * saturados en 65535.
+ *  Byte 0  Mensajes en la cola
+ *  Byte 1  Máximo número de mensajes en la cola
+ *  Byte 2-3  Mensajes descartados por cola llena
+ *  Byte 4-5  Latencia de cola máxima [us]
+ *  Byte 6-7  Latencia de cola promedio [us]
+ *
+ * CONTROL_DIAG_AUTOKILL: latencia del camino express de autokill hasta el fin de la transmisión
+ * del frame. La latencia de detección empieza con la recepción del frame que cambió el estado
+ * de un módulo a PROBLEM; la de solicitud, con la entrada a AUTOKILL. Valores de 16 bits
+ * little-endian, saturados en 65535.
+ *  Byte 0-1  Latencia de detección del último frame express [us]
+ *  Byte 2-3  Latencia de detección máxima [us]
+ *  Byte 4-5  Latencia de solicitud máxima [us]
+ *  Byte 6    Frames express transmitidos, saturado en 255
+ *  Byte 7    Frames express enviados por la cola (sin mailbox libre), saturado en 255
+ *
+ * CONTROL_DIAG_STARTUP: handshake de inicio (echo), tiempos desde el primer echo.
+ *  Byte 0-1  Tiempo hasta la confirmación de todos los módulos [ms], little-endian, saturado en 65535
+ *  Byte 2    Echos enviados, saturado en 255
+ *  Byte 3    Reservado (0)
+ *  Byte 4    Confirmación de BMS [100 ms], saturado en 255
+ *  Byte 5    Confirmación de DCDC [100 ms], saturado en 255
+ *  Byte 6    Confirmación de Inversor [100 ms], saturado en 255
+ *  Byte 7    Confirmación de Periféricos [100 ms], saturado en 255
+ *
+ * CONTROL_DIAG_CPU: carga de CPU (tiempo fuera de WFI) por ventana de 1 s. Valores de 16 bits
+ * little-endian, saturados en 65535.
+ *  Byte 0-1  Carga de la última ventana [0.1 %]
+ *  Byte 2-3  Carga máxima de una ventana [0.1 %]
+ *  Byte 4-5  Salidas de WFI en la última ventana
+ *  Byte 6-7  Reservado (0)
+ *
+ * CONTROL_DIAG_PROFILING: tiempo de ejecución de un punto de medición (profiling.h); cada frame
+ * lleva el siguiente punto, por lo que la tabla completa se transmite cada
+ * kPROFILE_COUNT * 100 ms. Tiempos de 16 bits little-endian [0.1 us], saturados en 65535.
+ * Solo existe con PROFILING_ENABLED en 1 (main.h).
+ *  Byte 0    Punto de medición (profiling_probe_t)
+ *  Byte 1-2  Tiempo mínimo
+ *  Byte 3-4  Tiempo máximo
+ *  Byte 5-6  Tiempo promedio
+ *  Byte 7    Ejecuciones desde el frame anterior del mismo punto [8 ejecuciones], redondeado
+ *            hacia arriba y saturado en 255
+ *
+ * CONTROL_DIAG_RAM: uso de RAM (ver ram_monitor.h). Valores de 16 bits little-endian [bytes],
+ * saturados en 65535.
+ *  Byte 0-1  Máximo uso de stack (MSP)
+ *  Byte 2-3  Stack reservado (_Min_Stack_Size)
+ *  Byte 4-5  Máximo uso de heap
+ *  Byte 6-7  Heap reservado (_Min_Heap_Size)
+ *
+ * CONTROL_DIAG_RAMPA: limitador de pendiente de la rampa pedal (ver rampa_pedal.h).
+ *  Byte 0    Nivel objetivo [0:100]
+ *  Byte 1    Nivel enviado a inversor [0:100]
+ *  Byte 2-3  Salida del limitador [1/256 nivel], little-endian
+ *  Byte 4    Estado: bit 0 subida limitada, bit 1 bajada limitada
+ *  Byte 5    Reservado (0)
+ *  Byte 6-7  Pasadas con la salida limitada, little-endian, saturado en 65535
+ */
+#if PROFILING_ENABLED == 1
+#define CAN_DIAG_IF_PROFILING(...)      __VA_ARGS__
+#else
+#define CAN_DIAG_IF_PROFILING(...)
+#endif /* PROFILING_ENABLED */
+
+#define CAN_DIAG_FRAMES(X) \
+    X(CONTROL_DIAG_CAN,                                 0x0F0,  1000) \
+    X(CONTROL_DIAG_CAN_TX,                              0x0F1,  1000) \
+    X(CONTROL_DIAG_AUTOKILL,                            0x0F2,  1000) \
+    X(CONTROL_DIAG_STARTUP,                             0x0F3,  5000) \
+    X(CONTROL_DIAG_CPU,                                 0x0F4,  1000) \
+    CAN_DIAG_IF_PROFILING(X(CONTROL_DIAG_PROFILING,     0x0F5,  100)) \
+    X(CONTROL_DIAG_RAM,                                 0x0F6,  1000) \
+    X(CONTROL_DIAG_RAMPA,                               0x0F7,  100)
+
+/********************************************************************************
+ *                                  CAN IDs                                     *
+ *******************************************************************************/
+
+#define CAN_DEF_ID(module, id_name, id, dir, fifo, field, type, decode, dest, scale, offset, period_ms) \
+    CAN_ID_##id_name = id,
+
+#define CAN_DEF_PACKED_ID(module, id_name, id, dir, fifo, first_id_name, first_field) \
+    CAN_ID_##id_name = id,
+
+#define CAN_DEF_DIAG_ID(id_name, id, period_ms) \
+    CAN_ID_##id_name = id,
+
+/** @brief Standard identifiers de todas las señales CAN, de los frames empaquetados y de diagnóstico */
+enum can_ids
+{
+    CAN_SIGNALS(CAN_DEF_ID)
+
+    CAN_PACKED_FRAMES(CAN_DEF_PACKED_ID)
+
+    CAN_DIAG_FRAMES(CAN_DEF_DIAG_ID)
+};
+
+#undef CAN_DEF_ID
+#undef CAN_DEF_PACKED_ID
+#undef CAN_DEF_DIAG_ID
 
 /********************************************************************************
  *                                CAN values                                    *
@@ -16,6 +16,9 @@
  * Included files
  **********************************************************************************************************************/
 
+/* C includes */
+#include <string.h>
+
 /* STM32 specific hardware configuration includes */
 #include "can.h"
 #include "tim.h"
@@ -24,6 +27,9 @@
 #include "can_api.h"
 #include "can_wrapper.h"
 
+/* Timebase include */
+#include "timebase.h"
+
 /* STM32 HAL include */
 #include "main.h"
 
@@ -31,29 +37,139 @@
  * Macros
  **********************************************************************************************************************/
 
+/** @brief Número de mensajes del buffer de recepción CAN (debe ser potencia de 2) */
+#define CAN_RX_BUFFER_SIZE			16U
+
+/** @brief Máscara de índices del buffer de recepción CAN */
+#define CAN_RX_BUFFER_MASK			(CAN_RX_BUFFER_SIZE - 1U)
+
+#if (CAN_RX_BUFFER_SIZE & CAN_RX_BUFFER_MASK) != 0U
+#error "CAN_RX_BUFFER_SIZE debe ser potencia de 2"
+#endif
+
+/** @brief Número de mensajes de la cola de transmisión CAN */
+#define CAN_TX_QUEUE_SIZE			16U
+
+/** @brief Mailboxes de transmisión reservados para frames express (la cola usa el resto) */
+#define CAN_TX_RESERVED_MAILBOXES	1U
+
+/** @brief Tiempo [ms] en bus-off antes de reiniciar el periférico CAN */
+#define CAN_BUSOFF_RECOVERY_TIME_MS	100U
+
+/** @brief Periodo [ms] de slot de transmisión CAN (TIM7) */
+#define CAN_TX_SLOT_MS				10U
+
 /***********************************************************************************************************************
  * Types declarations
  **********************************************************************************************************************/
 
 /**
- * @brief Tipo de dato can_rx_status_t para estado de recepción de mensaje CAN
+ * @brief Tipo de dato can_rx_buffer_t para buffer circular de recepción CAN.
+ *
+ * Se usa un buffer por cada FIFO de recepción de hardware.
+ *
+ * Buffer single-producer/single-consumer: el callback de recepción (ISR) es el único
+ * que escribe head, y el loop principal es el único que escribe tail. Los índices
+ * avanzan libremente y se enmascaran al acceder, por lo que head - tail es siempre
+ * el número de mensajes en el buffer.
+ *
+ */
+typedef struct
+{
+	can_frame_t 		frames[CAN_RX_BUFFER_SIZE];	/**< Mensajes recibidos */
+	volatile uint32_t	head;						/**< Índice de escritura (ISR) */
+	volatile uint32_t	tail;						/**< Índice de lectura (loop principal) */
+	volatile uint32_t	overflow_count;				/**< Mensajes descartados por buffer lleno */
+	volatile uint32_t	high_water;					/**< Máximo número de mensajes en el buffer */
+} can_rx_buffer_t;
+
+/**
+ * @brief Tipo de dato can_tx_entry_t para mensaje en cola de transmisión CAN
+ *
+ */
+typedef struct
+{
+	uint32_t	id;								/**< Standard identifier */
+	uint8_t		dlc;							/**< Length of frame */
+	uint8_t		data[PAYLOAD_MAX_LENGTH];		/**< Payload */
+	uint32_t	queued_us;						/**< Tiempo [us] de entrada a la cola */
+} can_tx_entry_t;
+
+/**
+ * @brief Tipo de dato can_tx_queue_t para cola de transmisión CAN.
+ *
+ * Cola acotada ordenada por prioridad de arbitraje CAN (ID menor primero; FIFO entre
+ * mensajes del mismo ID). Se escribe desde el loop principal o desde interrupciones, y
+ * se vacía hacia los tres mailboxes de hardware desde la interrupción de mailbox libre.
+ * Todos los accesos se hacen con interrupciones deshabilitadas.
  *
  */
-typedef enum
+typedef struct
 {
-	CAN_MSG_RECEIVED = 0, 		/**< Mensaje CAN recibido */
-    CAN_MSG_NOT_RECEIVED   		/**< Mensaje CAN no recibido */
-} can_rx_status_t;
+	can_tx_entry_t		entries[CAN_TX_QUEUE_SIZE];	/**< Mensajes en espera de mailbox */
+	uint32_t			count;						/**< Número de mensajes en la cola */
+} can_tx_queue_t;
 
 /**
- * @brief Tipo de dato can_tx_status_t para estado de transmisión de mensaje CAN
+ * @brief Tipo de dato can_tx_queue_stats_t para estadísticas de la cola de transmisión CAN.
+ *
+ * La latencia de cola es el tiempo desde que un mensaje entra a la cola hasta que se
+ * carga en un mailbox de hardware.
  *
  */
-typedef enum
+typedef struct
 {
-    CAN_TX_READY = 0, 		/**< Listo para transmitir mensaje CAN */
-    CAN_TX_NOT_READY   		/**< No listo para transmitir mensaje CAN */
-} can_tx_status_t;
+	volatile uint32_t	depth;					/**< Mensajes en la cola */
+	volatile uint32_t	high_water;				/**< Máximo número de mensajes en la cola */
+	volatile uint32_t	queued;					/**< Mensajes aceptados en la cola */
+	volatile uint32_t	sent;					/**< Mensajes cargados en un mailbox */
+	volatile uint32_t	drops;					/**< Mensajes descartados por cola llena */
+	volatile uint32_t	latency_last_us;		/**< Latencia de cola del último mensaje */
+	volatile uint32_t	latency_max_us;			/**< Latencia de cola máxima */
+	volatile uint32_t	latency_sum_us;			/**< Suma de latencias de cola (promedio: latency_sum_us / sent) */
+} can_tx_queue_stats_t;
+
+/**
+ * @brief Tipo de dato can_express_stats_t para estadísticas de frames express.
+ *
+ * Ambas latencias terminan cuando el frame express termina de transmitirse (interrupción de
+ * transmisión completa). La latencia de detección empieza con la recepción del frame CAN que
+ * originó el evento, por lo que incluye el buffer de recepción, la decodificación y las tareas
+ * que detectan el evento; la latencia de solicitud empieza con CAN_HW_Send_Express.
+ *
+ */
+typedef struct
+{
+	volatile uint32_t	requests;				/**< Frames express solicitados */
+	volatile uint32_t	sent;					/**< Frames express transmitidos */
+	volatile uint32_t	fallbacks;				/**< Frames express sin mailbox libre, enviados por la cola */
+	volatile uint32_t	latency_last_us;		/**< Latencia de detección del último frame express */
+	volatile uint32_t	latency_max_us;			/**< Latencia de detección máxima */
+	volatile uint32_t	request_latency_last_us;	/**< Latencia de solicitud del último frame express */
+	volatile uint32_t	request_latency_max_us;	/**< Latencia de solicitud máxima */
+} can_express_stats_t;
+
+/**
+ * @brief Tipo de dato can_error_stats_t para estadísticas de errores CAN.
+ *
+ * Los contadores de eventos se actualizan desde el callback de error (interrupciones de
+ * estado/error y de overrun de FIFO). TEC, REC y estado de error se leen del registro ESR
+ * en cada pasada del loop principal.
+ *
+ */
+typedef struct
+{
+	volatile uint32_t	rx_fifo_overrun[2];		/**< Mensajes perdidos por FIFO de hardware lleno, por FIFO */
+	volatile uint32_t	error_warning;			/**< Entradas a estado error warning (TEC o REC >= 96) */
+	volatile uint32_t	error_passive;			/**< Entradas a estado error passive (TEC o REC >= 128) */
+	volatile uint32_t	bus_off;				/**< Entradas a estado bus-off (TEC >= 256) */
+	volatile uint32_t	bus_off_recoveries;		/**< Reinicios del periférico por bus-off */
+	volatile uint32_t	bus_errors;				/**< Errores de protocolo (stuff, form, ACK, bit, CRC) */
+	volatile uint32_t	error_flags;			/**< Estado de error actual (bits EWGF, EPVF y BOFF de ESR) */
+	volatile uint8_t	tec;					/**< Transmit error counter */
+	volatile uint8_t	rec;					/**< Receive error counter */
+	volatile uint8_t	last_error_code;		/**< Último código de error de protocolo (campo LEC de ESR) */
+} can_error_stats_t;
 
 /***********************************************************************************************************************
  * Public function prototypes
@@ -61,14 +177,33 @@ typedef enum
 
 void CAN_HW_Init(void);
 
+bool CAN_HW_Get_ReceivedFrame(can_frame_t *frame);
+
+uint32_t CAN_HW_Get_RxOverflowCount(can_rx_fifo_t fifo);
+
+uint32_t CAN_HW_Get_RxHighWater(can_rx_fifo_t fifo);
+
+void CAN_HW_Process(void);
+
+const can_error_stats_t *CAN_HW_Get_ErrorStats(void);
+
+can_status_t CAN_HW_Queue_Frame(uint32_t id, uint8_t ide, uint8_t rtr, uint8_t dlc, uint8_t *data);
+
+const can_tx_queue_stats_t *CAN_HW_Get_TxQueueStats(void);
+
+can_status_t CAN_HW_Send_Express(uint32_t id, uint8_t dlc, const uint8_t *data, uint32_t detect_us);
+
+const can_express_stats_t *CAN_HW_Get_ExpressStats(void);
+
+bool CAN_HW_Service_RxFifo(can_rx_fifo_t fifo);
+
+bool CAN_HW_Service_TxMailboxes(void);
+
 /***********************************************************************************************************************
  * Global variables declarations
  **********************************************************************************************************************/
 
-/** Bandera mensaje recibido CAN */
-extern can_rx_status_t flag_rx_can;
-
-/** Bandera transmisión CAN */
-extern can_tx_status_t flag_tx_can;
+/** Contador de slots de transmisión CAN */
+extern volatile uint32_t can_tx_slot_count;
 
 #endif /* _CAN_HW_H_ */
@@ -0,0 +1,169 @@
+/**
+ * @file can_tx.h
+ * @author Subgrupo Control y Periféricos - Elektron Motorsports
+ * @brief Archivo header para can_tx.c
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef _CAN_TX_H_
+#define _CAN_TX_H_
+
+/***********************************************************************************************************************
+ * Included files
+ **********************************************************************************************************************/
+
+/* C includes */
+#include <stddef.h>
+#include <string.h>
+
+/* CAN driver include */
+#include "can_api.h"
+
+/* CAN application includes */
+#include "can_hw.h"
+#include "can_def.h"
+
+/* Application includes */
+#include "buses.h"
+
+/* STM32 HAL include */
+#include "main.h"
+
+/***********************************************************************************************************************
+ * Types declarations
+ **********************************************************************************************************************/
+
+#define CAN_TX_FRAME(module, id_name, id, dir, fifo, field, type, decode, dest, scale, offset, period_ms) \
+    CAN_SIGNAL_IF_LEGACY(module, CAN_SIGNAL_IF_TX(dir, kTX_FRAME_##id_name,))
+
+#define CAN_TX_PACKED_FRAME(module, id_name, id, dir, fifo, first_id_name, first_field) \
+    CAN_SIGNAL_IF_PACKED(module, CAN_SIGNAL_IF_TX(dir, kTX_FRAME_##id_name,))
+
+/**
+ * @brief Índice de cada frame de salida del planificador de transmisión CAN
+ *
+ * Un frame por cada señal TX del registro, o el frame empaquetado de Control si
+ * CAN_PACKED_FRAME_CONTROL está habilitado.
+ *
+ */
+typedef enum
+{
+    CAN_SIGNALS(CAN_TX_FRAME)
+
+    CAN_PACKED_FRAMES(CAN_TX_PACKED_FRAME)
+
+    kTX_FRAME_COUNT
+} can_tx_frame_t;
+
+#undef CAN_TX_FRAME
+#undef CAN_TX_PACKED_FRAME
+
+/** @brief Frame de salida que lleva el evento autokill */
+#if CAN_PACKED_FRAME_CONTROL == 1
+#define CAN_TX_FRAME_AUTOKILL       kTX_FRAME_CONTROL_PACKED
+#else
+#define CAN_TX_FRAME_AUTOKILL       kTX_FRAME_CONTROL_AUTOKILL
+#endif /* CAN_PACKED_FRAME_CONTROL */
+
+/**
+ * @brief Tipo de dato can_tx_stats_t para estadísticas de transmisión de un frame de salida.
+ *
+ * El intervalo es el tiempo entre transmisiones consecutivas (resolución de 1 ms):
+ * interval_min_ms no debe bajar del intervalo mínimo por cambio de valor, e interval_max_ms
+ * no debe superar el máximo silencio (heartbeat). Las transmisiones inmediatas
+ * (CAN_TX_Send_All, CAN_TX_Send_Express) no respetan el intervalo mínimo, pero cuentan en
+ * los intervalos y en forced.
+ *
+ */
+typedef struct
+{
+    uint32_t    heartbeats;         /**< Transmisiones por máximo silencio */
+    uint32_t    events;             /**< Transmisiones por cambio de valor */
+    uint32_t    forced;             /**< Transmisiones inmediatas (CAN_TX_Send_All, CAN_TX_Send_Express) */
+    uint32_t    deferred;           /**< Cambios de valor retrasados por el intervalo mínimo */
+    uint32_t    interval_min_ms;    /**< Intervalo mínimo entre transmisiones */
+    uint32_t    interval_max_ms;    /**< Intervalo máximo entre transmisiones */
+    uint32_t    interval_sum_ms;    /**< Suma de intervalos (promedio: interval_sum_ms / (heartbeats + events + forced - 1)) */
+} can_tx_stats_t;
+
+/***********************************************************************************************************************
+ * Public function prototypes
+ **********************************************************************************************************************/
+
+/**
+ * @brief Función principal del planificador de transmisión CAN.
+ *
+ * Transmite los frames de salida cuyo valor cambió (respetando su intervalo mínimo) y los
+ * frames que llegaron a su máximo silencio (heartbeat). Se llama en cada pasada del loop
+ * principal, para transmitir un cambio sin esperar un slot de transmisión.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param now_ms Tick actual [ms]
+ * @retval None
+ */
+void CAN_TX_Process(uint32_t now_ms);
+
+/**
+ * @brief Transmite inmediatamente todos los frames de salida de un bus de salida CAN.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param bus_can_output Puntero a estructura de tipo typedef_bus2_t (bus de salida CAN)
+ * @retval None
+ */
+void CAN_TX_Send_All(const typedef_bus2_t *bus_can_output);
+
+/**
+ * @brief Transmite de inmediato un frame de salida por el camino express (mailbox reservado).
+ *
+ * Para eventos de latencia crítica (autokill): no espera al planificador de transmisión ni
+ * a la cola de transmisión CAN.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param frame Frame de salida
+ * @param detect_us Tiempo [us] de recepción del frame CAN que originó el evento (latencia de detección)
+ * @return can_status_t CAN_STATUS_ERROR si el frame no se pudo transmitir
+ */
+can_status_t CAN_TX_Send_Express(can_tx_frame_t frame, uint32_t detect_us);
+
+/**
+ * @brief Transmite un frame CAN.
+ *
+ * Los frames que no se pueden transmitir se cuentan en CAN_TX_Get_ErrorCount.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param id Standard identifier
+ * @param payload Datos a transmitir
+ * @param length Número de bytes a transmitir
+ * @return can_status_t CAN_STATUS_ERROR si el frame no se pudo transmitir
+ */
+can_status_t CAN_TX_Send_Frame(uint32_t id, const uint8_t *payload, uint8_t length);
+
+/**
+ * @brief Estadísticas de transmisión de un frame de salida.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param frame Frame de salida
+ * @return const can_tx_stats_t* Estadísticas del frame
+ */
+const can_tx_stats_t *CAN_TX_Get_Stats(can_tx_frame_t frame);
+
+/**
+ * @brief Número de frames CAN que no se pudieron transmitir.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param None
+ * @return uint32_t Frames no transmitidos
+ */
+uint32_t CAN_TX_Get_ErrorCount(void);
+
+#endif /* _CAN_TX_H_ */
@@ -25,14 +25,16 @@
  **********************************************************************************************************************/
 
 /**
- * @brief Tipo de dato decode_status_t para bandera de decodificación
+ * @brief Etapas posteriores a la decodificación que solo procesan las variables con valor nuevo
  *
  */
 typedef enum
 {
-    DECODIFICA = 0, 	/**< Valor para decodificar */
-    NO_DECODIFICA   	/**< Valor para no decodificar */
-} decode_status_t;
+    kDECODE_CONSUMER_MONITORING = 0,    /**< Monitoreo de módulos */
+    kDECODE_CONSUMER_RAMPA_PEDAL,       /**< Rampa pedal */
+
+    kDECODE_CONSUMER_COUNT
+} decode_consumer_t;
 
 /***********************************************************************************************************************
  * Public function prototypes
@@ -41,9 +43,10 @@ typedef enum
 /**
  * @brief Función principal de decodificación de datos de bus de recepción CAN.
  *
- * Decodifica los datos que se reciben desde el bus CAN. Los datos decodificados quedan
- * guardados en estructuras de tipo rx_bms_vars_t, rx_dcdc_vars_t, rx_inversor_vars_t,
- * y rx_peripherals_vars_t, en el bus de datos.
+ * Decodifica las variables del bus de recepción CAN que cambiaron de valor desde la última
+ * decodificación (can_rx_dirty_signals). Los datos decodificados quedan guardados en
+ * estructuras de tipo rx_bms_vars_t, rx_dcdc_vars_t, rx_inversor_vars_t, y
+ * rx_peripherals_vars_t, en el bus de datos.
  *
  * No es static, por lo que puede ser usada por otros archivos.
  *
@@ -52,14 +55,17 @@ typedef enum
  */
 void DECODE_DATA_Process(void);
 
-/***********************************************************************************************************************
- * Global variables declarations
- **********************************************************************************************************************/
-
 /**
- * @brief Bandera para ejecutar bloque de decodificación de datos
+ * @brief Variables decodificadas con valor nuevo desde la última consulta de una etapa.
+ *
+ * Cada etapa tiene su propia máscara, porque las etapas corren con periodos distintos al de
+ * la decodificación. En la primera consulta se reportan todas las variables.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
  *
+ * @param consumer Etapa que consulta
+ * @return uint32_t Máscara de variables con valor nuevo (un bit por rx_signal_t)
  */
-extern decode_status_t flag_decodificar;
+uint32_t DECODE_DATA_Take_UpdatedSignals(decode_consumer_t consumer);
 
 #endif /* _DECODE_DATA_H_ */
@@ -19,6 +19,10 @@
 /* Application includes */
 #include "buses.h"
 
+/* CAN application includes */
+#include "can_app.h"
+#include "can_tx.h"
+
 /***********************************************************************************************************************
  * Macros
  **********************************************************************************************************************/
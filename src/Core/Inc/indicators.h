@@ -16,6 +16,10 @@
  * Included files
  **********************************************************************************************************************/
 
+/* C includes */
+#include <stdint.h>
+#include <stdbool.h>
+
 /* Application includes */
 #include "buses.h"
 
@@ -25,14 +29,46 @@
 /* STM32 HAL include */
 #include "main.h"
 
+/***********************************************************************************************************************
+ * Macros
+ **********************************************************************************************************************/
+
+/** @brief Periodo [ms] de actualización de los patrones de LEDs y buzzer (TIM7) */
+#define INDICATORS_TICK_MS              10U
+
 /***********************************************************************************************************************
  * Public function prototypes
  **********************************************************************************************************************/
 
+/**
+ * @brief Inicialización de los patrones de LEDs y buzzer.
+ *
+ * Inicia el patrón de inicialización de la tarjeta (tres parpadeos de los LEDs). Los LEDs y el
+ * buzzer deben estar inicializados (BSP).
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param None
+ * @retval None
+ */
+void INDICATORS_Init(void);
+
+/**
+ * @brief Avanza los patrones de LEDs y buzzer. Se llama desde la interrupción de TIM7,
+ * cada INDICATORS_TICK_MS.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param None
+ * @retval None
+ */
+void INDICATORS_Tick(void);
+
 /**
  * @brief Función principal bloque generación de indicadores.
  * 
- * Por defecto, actualiza LEDs de acuerdo al modo de manejo actual.
+ * Selecciona el patrón de LEDs de acuerdo al modo de manejo actual y el patrón de buzzer de
+ * acuerdo al nivel de falla actual.
  *
  * No es static, por lo que puede ser usada por otros archivos.
  *
@@ -54,6 +90,8 @@ void INDICATORS_Update_ModulesLEDs(void);
 /**
  * @brief Indicación de que la tarjeta ha finalizado la inicialización.
  *
+ * Inicia el patrón de fin de inicialización (LEDs parpadeando y buzzer); no bloquea.
+ *
  * No es static, por lo que puede ser usada por otros archivos.
  *
  * @param None
@@ -42,11 +42,56 @@ extern "C" {
 /* Exported constants --------------------------------------------------------*/
 /* USER CODE BEGIN EC */
 
+/*
+ * Perfiles de reloj. Control.ioc y SystemClock_Config (generada) describen el perfil de bajo
+ * consumo; el de rendimiento lo aplica SystemClock_Config_Performance desde USER CODE SysInit.
+ * CAN, TIM7 y el buzzer recalculan sus prescalers en secciones USER CODE a partir de los
+ * relojes configurados, por lo que la tasa de bits y los periodos no cambian.
+ *
+ *  CLOCK_PROFILE_LOW_POWER     HSI, PLL a 80 MHz, escala de voltaje 3, 2 wait states,
+ *                              APB1 40 MHz, APB2 80 MHz
+ *  CLOCK_PROFILE_PERFORMANCE   HSE (8 MHz), PLL a 180 MHz, escala de voltaje 1 con overdrive,
+ *                              5 wait states, APB1 45 MHz, APB2 90 MHz
+ *
+ * En ambos perfiles HAL_Init habilita el prefetch y los caches de instrucciones y datos del
+ * acelerador ART (stm32f4xx_hal_conf.h): con wait states, sin prefetch cada salto o línea nueva
+ * fuera de cache espera a la flash.
+ */
+#define CLOCK_PROFILE_LOW_POWER         0
+#define CLOCK_PROFILE_PERFORMANCE       1
+
+/** @brief Perfil de reloj seleccionado */
+#define CLOCK_PROFILE                   CLOCK_PROFILE_LOW_POWER
+
+/*
+ * Ejecución desde SRAM de las interrupciones CAN y del camino de control (sección .RamFunc,
+ * copiada de flash a RAM por el startup junto con .data). Estas funciones siguen ejecutando
+ * mientras la flash está ocupada por un borrado o una escritura.
+ *
+ * En 0 se ejecutan desde flash; los puntos de medición de profiling.h permiten comparar los
+ * ciclos de ambas opciones.
+ */
+#define RAMFUNC_ENABLED                 1
+
+/*
+ * Habilita la medición de tiempo de ejecución con el contador de ciclos DWT (CYCCNT), ver
+ * profiling.h. En 0, PROFILING_START/PROFILING_STOP no generan código y no se transmite el
+ * frame CONTROL_DIAG_PROFILING.
+ */
+#define PROFILING_ENABLED               1
+
 /* USER CODE END EC */
 
 /* Exported macro ------------------------------------------------------------*/
 /* USER CODE BEGIN EM */
 
+#if RAMFUNC_ENABLED == 1
+/** @brief Ubica la función en SRAM (.RamFunc) */
+#define RAMFUNC                         __RAM_FUNC
+#else
+#define RAMFUNC
+#endif /* RAMFUNC_ENABLED */
+
 /* USER CODE END EM */
 
 /* Exported functions prototypes ---------------------------------------------*/
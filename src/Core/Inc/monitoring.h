@@ -19,6 +19,7 @@
 /* Application includes */
 #include "monitoring_api.h"
 #include "buses.h"
+#include "decode_data.h"
 
 /***********************************************************************************************************************
  * Public function prototypes
@@ -18,6 +18,7 @@
 
 /* Application includes */
 #include "types.h"
+#include "buses.h"
 
 /***********************************************************************************************************************
  * Types declarations
@@ -78,10 +79,12 @@ typedef struct
  * @param Rx_Bms Puntero a estructura con variables decodificadas del BMS
  * @param St_Bms Puntero a estructura con estado de variables decodificadas del BMS
  * @param bms_limits Puntero a estructura con los límites de las variables del BMS
+ * @param stale_signals Máscara de variables del bus de entrada CAN vencidas (un bit por rx_signal_t)
  */
 void MONITORING_API_Bms_VariableMonitoring( rx_bms_vars_t* Rx_Bms,
                                             st_bms_vars_t* St_Bms,
-                                            const rx_bms_limits_t* bms_limits);
+                                            const rx_bms_limits_t* bms_limits,
+                                            uint32_t stale_signals);
 
 /**
  * @brief Monitoreo de las variables del DCDC. Module Analog Variable -> Variable State
@@ -89,10 +92,12 @@ void MONITORING_API_Bms_VariableMonitoring( rx_bms_vars_t* Rx_Bms,
  * @param Rx_Dcdc Puntero a estructura con variables decodificadas del DCDC
  * @param St_Dcdc Puntero a estructura con estado de variables decodificadas del DCDC
  * @param dcdc_limits Puntero a estructura con los límites de las variables del DCDC
+ * @param stale_signals Máscara de variables del bus de entrada CAN vencidas (un bit por rx_signal_t)
  */
 void MONITORING_API_Dcdc_VariableMonitoring(    rx_dcdc_vars_t* Rx_Dcdc,
                                                 st_dcdc_vars_t* St_Dcdc,
-                                                const rx_dcdc_limits_t* dcdc_limits);
+                                                const rx_dcdc_limits_t* dcdc_limits,
+                                                uint32_t stale_signals);
 
 /**
  * @brief Monitoreo de las variables del inversor. Module Analog Variable -> Variable State
@@ -100,36 +105,47 @@ void MONITORING_API_Dcdc_VariableMonitoring(    rx_dcdc_vars_t* Rx_Dcdc,
  * @param Rx_Inversor Puntero a estructura con variables decodificadas del inversor
  * @param St_Inversor Puntero a estructura con estado de variables decodificadas del inversor
  * @param inversor_limits Puntero a estructura con los límites de las variables del inversor
+ * @param stale_signals Máscara de variables del bus de entrada CAN vencidas (un bit por rx_signal_t)
  */
 void MONITORING_API_Inversor_VariableMonitoring(    rx_inversor_vars_t* Rx_Inversor,
                                                     st_inversor_vars_t* St_Inversor,
-                                                    const rx_inversor_limits_t* inversor_limits);
+                                                    const rx_inversor_limits_t* inversor_limits,
+                                                    uint32_t stale_signals);
 
 /* ------------------------------------------------------------------------------------------------------------------ */
 
 /**
  * @brief Retorna estado del módulo BMS de acuerdo al valor de la variable de estado de módulo recibida (bms_ok).
  *
+ * Si bms_ok dejó de recibirse (variable vencida), el estado es kMODULE_STATUS_DATA_PROBLEM.
+ *
  * @param Rx_Bms Puntero a estructura con variables decodificadas del BMS
+ * @param stale_signals Máscara de variables del bus de entrada CAN vencidas (un bit por rx_signal_t)
  * @return module_status_t
  */
-module_status_t MONITORING_API_Get_Bms_ReceivedStatus( rx_bms_vars_t* Rx_Bms);
+module_status_t MONITORING_API_Get_Bms_ReceivedStatus( rx_bms_vars_t* Rx_Bms, uint32_t stale_signals);
 
 /**
  * @brief Retorna estado del módulo DCDC de acuerdo al valor de la variable de estado de módulo recibida (dcdc_ok).
  *
+ * Si dcdc_ok dejó de recibirse (variable vencida), el estado es kMODULE_STATUS_DATA_PROBLEM.
+ *
  * @param Rx_Dcdc Puntero a estructura con variables decodificadas del DCDC
+ * @param stale_signals Máscara de variables del bus de entrada CAN vencidas (un bit por rx_signal_t)
  * @return module_status_t
  */
-module_status_t MONITORING_API_Get_Dcdc_ReceivedStatus( rx_dcdc_vars_t* Rx_Dcdc);
+module_status_t MONITORING_API_Get_Dcdc_ReceivedStatus( rx_dcdc_vars_t* Rx_Dcdc, uint32_t stale_signals);
 
 /**
  * @brief Retorna estado del módulo Inversor de acuerdo al valor de la variable de estado de módulo recibida (inversor_ok).
  *
+ * Si inversor_ok dejó de recibirse (variable vencida), el estado es kMODULE_STATUS_DATA_PROBLEM.
+ *
  * @param Rx_Inversor Puntero a estructura con variables decodificadas del inversor
+ * @param stale_signals Máscara de variables del bus de entrada CAN vencidas (un bit por rx_signal_t)
  * @return module_status_t
  */
-module_status_t MONITORING_API_Get_Inversor_ReceivedStatus( rx_inversor_vars_t* Rx_Inversor);
+module_status_t MONITORING_API_Get_Inversor_ReceivedStatus( rx_inversor_vars_t* Rx_Inversor, uint32_t stale_signals);
 
 /* ------------------------------------------------------------------------------------------------------------------ */
 
@@ -0,0 +1,169 @@
+/**
+ * @file profiling.h
+ * @author Subgrupo Control y Periféricos - Elektron Motorsports
+ * @brief Archivo header para profiling.c
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef _PROFILING_H_
+#define _PROFILING_H_
+
+/***********************************************************************************************************************
+ * Included files
+ **********************************************************************************************************************/
+
+/* C includes */
+#include <stdint.h>
+
+/* Application include */
+#include "scheduler.h"
+
+/* STM32 HAL include */
+#include "main.h"
+
+/***********************************************************************************************************************
+ * Macros
+ **********************************************************************************************************************/
+
+/*
+ * Interrupciones medidas, además de cada tarea del scheduler (SCHEDULER_TASKS).
+ *
+ * X(name)  Nombre de la interrupción (kPROFILE_ISR_<name>)
+ */
+#define PROFILING_ISRS(X) \
+    X(CAN1_TX)      \
+    X(CAN1_RX0)     \
+    X(CAN1_RX1)     \
+    X(CAN1_SCE)     \
+    X(TIM7)
+
+/***********************************************************************************************************************
+ * Types declarations
+ **********************************************************************************************************************/
+
+#define PROFILING_TASK_PROBE(name, function, period_ms, offset_ms, deadline_us, budget_us) \
+    kPROFILE_TASK_##name,
+
+#define PROFILING_ISR_PROBE(name) \
+    kPROFILE_ISR_##name,
+
+/**
+ * @brief Punto de medición: una tarea del scheduler o una interrupción
+ *
+ * Las tareas van primero y en el orden de SCHEDULER_TASKS, por lo que kPROFILE_TASK_<name>
+ * es igual a kTASK_<name>.
+ *
+ */
+typedef enum
+{
+    SCHEDULER_TASKS(PROFILING_TASK_PROBE)
+
+    PROFILING_ISRS(PROFILING_ISR_PROBE)
+
+    kPROFILE_COUNT
+} profiling_probe_t;
+
+#undef PROFILING_TASK_PROBE
+#undef PROFILING_ISR_PROBE
+
+/** @brief Punto de medición de una tarea del scheduler */
+#define PROFILING_TASK(task)            ((profiling_probe_t)(task))
+
+/**
+ * @brief Tipo de dato profiling_stats_t para tiempo de ejecución de un punto de medición.
+ *
+ * Los tiempos son en ciclos de CPU e incluyen las interrupciones de mayor prioridad que
+ * interrumpieron la ejecución.
+ *
+ */
+typedef struct
+{
+    uint32_t    count;              /**< Ejecuciones medidas */
+    uint32_t    min_cycles;         /**< Tiempo mínimo */
+    uint32_t    max_cycles;         /**< Tiempo máximo */
+    uint64_t    sum_cycles;         /**< Suma de tiempos (promedio: sum_cycles / count) */
+} profiling_stats_t;
+
+/***********************************************************************************************************************
+ * Global variables declarations
+ **********************************************************************************************************************/
+
+#if PROFILING_ENABLED == 1
+/** @brief Tiempo de ejecución de cada punto de medición */
+extern profiling_stats_t profiling_stats[kPROFILE_COUNT];
+#endif /* PROFILING_ENABLED */
+
+/***********************************************************************************************************************
+ * Public function prototypes
+ **********************************************************************************************************************/
+
+/**
+ * @brief Inicialización del contador de ciclos DWT y de las estadísticas de ejecución.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param None
+ * @retval None
+ */
+void PROFILING_Init(void);
+
+#if PROFILING_ENABLED == 1
+
+/**
+ * @brief Tiempo de ejecución de un punto de medición.
+ *
+ * Las estadísticas de interrupciones se actualizan en la interrupción, por lo que los campos
+ * leídos pueden corresponder a ejecuciones distintas.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param probe Punto de medición
+ * @return const profiling_stats_t* Tiempo de ejecución
+ */
+const profiling_stats_t *PROFILING_Get_Stats(profiling_probe_t probe);
+
+/**
+ * @brief Registra un tiempo de ejecución. Usar a través de PROFILING_STOP.
+ *
+ * Cada punto de medición debe registrarse desde un solo contexto (tarea o interrupción).
+ *
+ * @param probe Punto de medición
+ * @param cycles Tiempo de ejecución [ciclos]
+ * @retval None
+ */
+static inline RAMFUNC void PROFILING_Record(profiling_probe_t probe, uint32_t cycles)
+{
+    profiling_stats_t *stats = &profiling_stats[probe];
+
+    stats->count++;
+    stats->sum_cycles += cycles;
+
+    if (cycles > stats->max_cycles)
+    {
+        stats->max_cycles = cycles;
+    }
+
+    if (cycles < stats->min_cycles)
+    {
+        stats->min_cycles = cycles;
+    }
+}
+
+/** @brief Inicio de la medición (una por bloque) */
+#define PROFILING_START()               uint32_t profiling_start_cycles = DWT->CYCCNT
+
+/** @brief Fin de la medición iniciada con PROFILING_START en el mismo bloque */
+#define PROFILING_STOP(probe)           PROFILING_Record((probe), DWT->CYCCNT - profiling_start_cycles)
+
+#else
+
+#define PROFILING_START()
+#define PROFILING_STOP(probe)
+
+#endif /* PROFILING_ENABLED */
+
+#endif /* _PROFILING_H_ */
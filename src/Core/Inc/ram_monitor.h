@@ -0,0 +1,77 @@
+/**
+ * @file ram_monitor.h
+ * @author Subgrupo Control y Periféricos - Elektron Motorsports
+ * @brief Archivo header para ram_monitor.c
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef _RAM_MONITOR_H_
+#define _RAM_MONITOR_H_
+
+/***********************************************************************************************************************
+ * Included files
+ **********************************************************************************************************************/
+
+/* C includes */
+#include <stdint.h>
+
+/* STM32 HAL include */
+#include "main.h"
+
+/***********************************************************************************************************************
+ * Macros
+ **********************************************************************************************************************/
+
+/** @brief Patrón de la RAM libre (heap y stack) sin usar, escrito en Reset_Handler */
+#define RAM_MONITOR_PAINT               0xC5C5C5C5UL
+
+/***********************************************************************************************************************
+ * Types declarations
+ **********************************************************************************************************************/
+
+/**
+ * @brief Tipo de dato ram_monitor_stats_t para uso de stack (MSP) y heap.
+ *
+ * Los tamaños reservados son los del linker script (_Min_Stack_Size, _Min_Heap_Size); un uso
+ * mayor al reservado ocupa RAM libre, que no se verifica en compilación.
+ *
+ */
+typedef struct
+{
+    uint32_t    stack_used_max;     /**< Máximo uso de stack [bytes] */
+    uint32_t    stack_size;         /**< Stack reservado [bytes] */
+    uint32_t    heap_used_max;      /**< Máximo uso de heap [bytes] */
+    uint32_t    heap_size;          /**< Heap reservado [bytes] */
+} ram_monitor_stats_t;
+
+/***********************************************************************************************************************
+ * Public function prototypes
+ **********************************************************************************************************************/
+
+/**
+ * @brief Función principal del monitor de RAM.
+ *
+ * Avanza la medición del máximo uso de stack (marca de agua) y actualiza el máximo uso de heap.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param None
+ * @retval None
+ */
+void RAM_MONITOR_Process(void);
+
+/**
+ * @brief Uso de stack y heap.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param None
+ * @return const ram_monitor_stats_t* Uso de stack y heap
+ */
+const ram_monitor_stats_t *RAM_MONITOR_Get_Stats(void);
+
+#endif /* _RAM_MONITOR_H_ */
@@ -18,22 +18,121 @@
  **********************************************************************************************************************/
 
 /* C includes */
-#include <math.h>
+#include <stdint.h>
+#include <stdbool.h>
 
 /* Application includes */
 #include "buses.h"
+#include "decode_data.h"
+
+/* STM32 HAL include */
+#include "main.h"
+
+/***********************************************************************************************************************
+ * Macros
+ **********************************************************************************************************************/
+
+/** @brief Número de modos de manejo con rampa */
+#define RAMPA_PEDAL_NUM_OF_MODES        (kDRIVING_MODE_SPORT + 1)
+
+/** @brief Puntos de la grilla de cada mapa de pedal: pedal 0, 20, 40, 60, 80 y 100 */
+#define RAMPA_PEDAL_MAP_POINTS          6U
+
+/** @brief Separación [pedal] entre puntos consecutivos de la grilla */
+#define RAMPA_PEDAL_MAP_STEP            20U
+
+/** @brief Nivel de velocidad máximo de un punto de mapa */
+#define RAMPA_PEDAL_MAP_MAX_LEVEL       100U
+
+/** @brief Periodo [ms] de la tarea de rampa pedal (SCHEDULER_TASKS); paso de tiempo del limitador de pendiente */
+#define RAMPA_PEDAL_PERIOD_MS           1U
+
+/** @brief Bits fraccionarios de la salida del limitador de pendiente */
+#define RAMPA_PEDAL_SLEW_FRAC_BITS      16U
+
+/***********************************************************************************************************************
+ * Types declarations
+ **********************************************************************************************************************/
+
+/**
+ * @brief Tipo de dato rampa_pedal_map_t para mapa de pedal calibrable.
+ *
+ * Nivel de velocidad [0:100] en cada punto de una grilla uniforme de pedal, para cada modo
+ * de manejo. Entre puntos se interpola linealmente. Un pedal mayor al último punto (100) está
+ * fuera de rango y da nivel 0.
+ *
+ */
+typedef struct
+{
+	uint8_t	points[RAMPA_PEDAL_NUM_OF_MODES][RAMPA_PEDAL_MAP_POINTS];	/**< Nivel de velocidad en cada punto, por modo */
+} rampa_pedal_map_t;
+
+/**
+ * @brief Tipo de dato rampa_pedal_slew_t para estado del limitador de pendiente.
+ *
+ * El limitador lleva la salida hacia el nivel objetivo de la rampa con una pendiente máxima
+ * de subida y de bajada por modo de manejo. La salida es de punto fijo, con
+ * RAMPA_PEDAL_SLEW_FRAC_BITS bits fraccionarios, para acumular pendientes menores a un nivel
+ * por periodo.
+ *
+ */
+typedef struct
+{
+	uint32_t	output;				/**< Salida [nivel, punto fijo] */
+	uint16_t	target;				/**< Nivel objetivo de la rampa [0:100], en el punto fijo de CAN */
+	uint16_t	level;				/**< Nivel enviado a inversor (salida redondeada) [0:100], en el punto fijo de CAN */
+	bool		rising;				/**< La última pasada limitó la subida */
+	bool		falling;			/**< La última pasada limitó la bajada */
+	uint32_t	limited_periods;	/**< Pasadas con la salida limitada */
+} rampa_pedal_slew_t;
 
 /***********************************************************************************************************************
  * Public function prototypes
  **********************************************************************************************************************/
 
+/**
+ * @brief Inicialización de la rampa pedal.
+ *
+ * Carga el mapa de pedal por defecto.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param   None
+ * @retval  None
+ */
+void RAMPA_PEDAL_Init(void);
+
+/**
+ * @brief Carga un mapa de pedal nuevo.
+ *
+ * El mapa se copia y se expande a tablas en el buffer de calibración inactivo, y se activa
+ * con una sola escritura del puntero de mapa activo: RAMPA_PEDAL_Process usa siempre un mapa
+ * completo. Puede ser llamada desde interrupciones.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param   map     Puntero al mapa a cargar
+ * @retval  true si se cargó; false si algún nivel es mayor a RAMPA_PEDAL_MAP_MAX_LEVEL o la
+ *          rampa aún no usó el mapa de la carga anterior
+ */
+bool RAMPA_PEDAL_Load_Map(const rampa_pedal_map_t *map);
+
 /**
  * @brief Función principal de bloque rampa pedal.
  *
  * Se encarga de transformar el valor de pedal registrado de periféricos a un valor de
  * velocidad que será empleado por inversor. Para cada modo de manejo se tiene una
  * función de transferencia diferente para determinar el valor de velocidad asociado al
- * valor de pedal registrado desde periféricos.
+ * valor de pedal registrado desde periféricos, precalculada en una tabla por modo a partir
+ * del mapa de pedal activo.
+ *
+ * Con CAN_HIGH_RES_PEDAL (can_def.h) el pedal y la velocidad son de 16 bits en punto fijo, y
+ * el mapa se interpola directamente en lugar de usar las tablas.
+ *
+ * El nivel objetivo solo se recalcula si cambió el pedal, el hombre muerto, el modo de manejo
+ * o el mapa activo. La velocidad enviada a inversor sigue al objetivo con la pendiente máxima
+ * del modo de manejo, avanzando un paso por cada RAMPA_PEDAL_PERIOD_MS transcurrido desde la
+ * pasada anterior, incluidas las liberaciones que el scheduler perdió.
  *
  * No es static, por lo que puede ser usada por otros archivos.
  *
@@ -42,4 +141,14 @@
  */
 void RAMPA_PEDAL_Process(void);
 
+/**
+ * @brief Estado del limitador de pendiente.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param None
+ * @return const rampa_pedal_slew_t* Estado del limitador
+ */
+const rampa_pedal_slew_t *RAMPA_PEDAL_Get_Slew(void);
+
 #endif /* _RAMPA_PEDAL_H_ */
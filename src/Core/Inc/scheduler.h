@@ -0,0 +1,192 @@
+/**
+ * @file scheduler.h
+ * @author Subgrupo Control y Periféricos - Elektron Motorsports
+ * @brief Archivo header para scheduler.c
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef _SCHEDULER_H_
+#define _SCHEDULER_H_
+
+/***********************************************************************************************************************
+ * Included files
+ **********************************************************************************************************************/
+
+/* C includes */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* STM32 HAL include */
+#include "main.h"
+
+/***********************************************************************************************************************
+ * Macros
+ **********************************************************************************************************************/
+
+/*
+ * Tabla de tareas del scheduler cooperativo, en orden de ejecución dentro de un mismo tick.
+ *
+ * Cada tarea se libera cada period_ms, desfasada offset_ms del inicio del scheduler, y debe
+ * terminar antes de deadline_us desde su liberación. budget_us es el tiempo de ejecución
+ * esperado de una pasada de la tarea.
+ *
+ * X(name, function, period_ms, offset_ms, deadline_us, budget_us)
+ *
+ *  name        Nombre de la tarea (kTASK_<name>)
+ *  function    Función de la tarea, void function(void)
+ *  period_ms   Periodo de liberación [ms]
+ *  offset_ms   Desfase de la primera liberación [ms]
+ *  deadline_us Plazo desde la liberación hasta el fin de la ejecución [us]
+ *  budget_us   Tiempo de ejecución máximo esperado [us]
+ *
+ * El periodo de RAMPA_PEDAL es el paso de tiempo de su limitador de pendiente (rampa_pedal.h).
+ */
+#define SCHEDULER_TASKS(X) \
+    X(CAN,              CAN_APP_Process,            1,      0,      1000,   300)    \
+    X(DECODE_DATA,      DECODE_DATA_Process,        1,      0,      1000,   100)    \
+    X(MONITORING,       MONITORING_Process,         10,     1,      2000,   50)     \
+    X(FAILURES,         FAILURES_Process,           10,     1,      2000,   50)     \
+    X(DRIVING_MODES,    DRIVING_MODES_Process,      10,     1,      2000,   50)     \
+    X(RAMPA_PEDAL,      RAMPA_PEDAL_Process,        RAMPA_PEDAL_PERIOD_MS,  0,  1000,   100)    \
+    X(INDICATORS,       INDICATORS_Process,         50,     2,      5000,   100)    \
+    X(RAM_MONITOR,      RAM_MONITOR_Process,        100,    3,      10000,  50)
+
+/** @brief Ventana [ms] de medición de carga de CPU */
+#define SCHEDULER_LOAD_WINDOW_MS        1000U
+
+/***********************************************************************************************************************
+ * Types declarations
+ **********************************************************************************************************************/
+
+#define SCHEDULER_TASK_ID(name, function, period_ms, offset_ms, deadline_us, budget_us) \
+    kTASK_##name,
+
+/**
+ * @brief Índice de cada tarea del scheduler
+ *
+ */
+typedef enum
+{
+    SCHEDULER_TASKS(SCHEDULER_TASK_ID)
+
+    kTASK_COUNT
+} scheduler_task_id_t;
+
+#undef SCHEDULER_TASK_ID
+
+/**
+ * @brief Tipo de dato scheduler_task_stats_t para estadísticas de ejecución de una tarea.
+ *
+ * La latencia es el tiempo desde la liberación de la tarea hasta el inicio de su ejecución.
+ * Una liberación perdida (overrun) ocurre cuando la tarea no alcanza a ejecutarse antes de su
+ * siguiente liberación; las liberaciones perdidas no se ejecutan.
+ *
+ */
+typedef struct
+{
+    uint32_t    runs;               /**< Ejecuciones */
+    uint32_t    overruns;           /**< Liberaciones perdidas */
+    uint32_t    deadline_misses;    /**< Ejecuciones terminadas después del plazo */
+    uint32_t    budget_overruns;    /**< Ejecuciones más largas que el presupuesto */
+    uint32_t    exec_last_us;       /**< Tiempo de ejecución de la última ejecución */
+    uint32_t    exec_max_us;        /**< Tiempo de ejecución máximo */
+    uint32_t    exec_sum_us;        /**< Suma de tiempos de ejecución (promedio: exec_sum_us / runs) */
+    uint32_t    latency_max_us;     /**< Latencia máxima de inicio */
+} scheduler_task_stats_t;
+
+/**
+ * @brief Tipo de dato scheduler_cpu_stats_t para carga de CPU.
+ *
+ * La carga es la fracción de cada ventana de SCHEDULER_LOAD_WINDOW_MS que el núcleo no
+ * estuvo dormido (WFI) en SCHEDULER_Idle.
+ *
+ */
+typedef struct
+{
+    uint32_t    load_permille;      /**< Carga de la última ventana [0.1 %] */
+    uint32_t    load_max_permille;  /**< Carga máxima de una ventana [0.1 %] */
+    uint32_t    wakeups;            /**< Salidas de WFI en la última ventana */
+    uint32_t    idle_sum_us;        /**< Tiempo total dormido (desborda cada ~71 minutos) */
+} scheduler_cpu_stats_t;
+
+/***********************************************************************************************************************
+ * Public function prototypes
+ **********************************************************************************************************************/
+
+/**
+ * @brief Inicialización del scheduler cooperativo.
+ *
+ * La primera liberación de cada tarea es offset_ms después de la inicialización.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param None
+ * @retval None
+ */
+void SCHEDULER_Init(void);
+
+/**
+ * @brief Función principal del scheduler cooperativo.
+ *
+ * Ejecuta, en orden de la tabla de tareas, cada tarea liberada desde la última pasada.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param None
+ * @retval None
+ */
+void SCHEDULER_Process(void);
+
+/**
+ * @brief Espera de la siguiente interrupción, si no hay tareas liberadas.
+ *
+ * Se llama al final de cada pasada del loop principal. Revisa con interrupciones deshabilitadas
+ * si hay tareas liberadas y, si no, duerme con WFI: una interrupción que llega entre la revisión
+ * y WFI queda pendiente y despierta al núcleo de inmediato, por lo que no se pierde. El tiempo
+ * dormido se usa para medir la carga de CPU.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param None
+ * @retval None
+ */
+void SCHEDULER_Idle(void);
+
+/**
+ * @brief Estadísticas de ejecución de una tarea.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param task Tarea
+ * @return const scheduler_task_stats_t* Estadísticas de la tarea
+ */
+const scheduler_task_stats_t *SCHEDULER_Get_TaskStats(scheduler_task_id_t task);
+
+/**
+ * @brief Tick de la liberación atendida por la tarea en ejecución.
+ *
+ * Si la tarea perdió liberaciones es la última de ellas, por lo que la diferencia con la
+ * liberación de la ejecución anterior incluye los periodos perdidos.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param None
+ * @return uint32_t Tick [ms] de la liberación
+ */
+uint32_t SCHEDULER_Get_ReleaseMs(void);
+
+/**
+ * @brief Carga de CPU.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param None
+ * @return const scheduler_cpu_stats_t* Carga de CPU
+ */
+const scheduler_cpu_stats_t *SCHEDULER_Get_CpuStats(void);
+
+#endif /* _SCHEDULER_H_ */
@@ -0,0 +1,39 @@
+/**
+ * @file timebase.h
+ * @author Subgrupo Control y Periféricos - Elektron Motorsports
+ * @brief Archivo header para timebase.c
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef _TIMEBASE_H_
+#define _TIMEBASE_H_
+
+/***********************************************************************************************************************
+ * Included files
+ **********************************************************************************************************************/
+
+/* C includes */
+#include <stdint.h>
+
+/* STM32 HAL include */
+#include "main.h"
+
+/***********************************************************************************************************************
+ * Public function prototypes
+ **********************************************************************************************************************/
+
+/**
+ * @brief Tiempo [us] desde el inicio, con base en SysTick.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param None
+ * @return uint32_t Tiempo [us]
+ */
+uint32_t TIMEBASE_Get_TimeUs(void);
+
+#endif /* _TIMEBASE_H_ */
@@ -16,13 +16,11 @@
 #include "app_control.h"
 
 #include "buses.h"
-#include "decode_data.h"
-#include "driving_modes.h"
-#include "failures.h"
-#include "rampa_pedal.h"
-#include "monitoring.h"
 #include "indicators.h"
 #include "can_app.h"
+#include "scheduler.h"
+#include "profiling.h"
+#include "rampa_pedal.h"
 
 #include "main.h"
 
@@ -33,9 +31,18 @@
 /** @brief Duración del echo en ms */
 #define ECHO_LENGTH_MS			1000U
 
-/** @brief Duración de la espera hasta timeout en ms */
+/** @brief Espera inicial en ms entre el fin de un echo y el siguiente, si faltan módulos por confirmar */
+#define ECHO_RETRY_MIN_MS		500U
+
+/** @brief Espera máxima en ms entre echos (la espera se duplica en cada reintento) */
 #define TIMEOUT_VALUE_MS       	5000U
 
+/** @brief Máscara con todos los módulos que deben confirmar el echo */
+#define STARTUP_ALL_MODULES		((1UL << kSTARTUP_MODULE_COUNT) - 1UL)
+
+/** @brief Entradas de la tabla de vectores: 16 excepciones del núcleo y las interrupciones del STM32F446 */
+#define VECTOR_TABLE_SIZE		(16U + (uint32_t)FMPI2C1_ER_IRQn + 1U)
+
 /***********************************************************************************************************************
  * Private variables definitions
  **********************************************************************************************************************/
@@ -50,14 +57,53 @@ enum App_States
 /** @brief Estado de la máquina de estados */
 static uint8_t app_state = kWAITING_ECHO_RESPONSE;
 
-/** Para conteo de timeout en estado kWAITING_ECHO_RESPONSE */
+/** @brief Estados posibles del echo en estado kWAITING_ECHO_RESPONSE */
+enum Echo_States
+{
+	kECHO_START = 0,					/**< Echo aún no enviado */
+	kECHO_PULSE,						/**< control_ok en MODULE_OK durante ECHO_LENGTH_MS */
+	kECHO_WAIT,							/**< control_ok en MODULE_IDLE, esperando a reenviar echo */
+};
+
+/** @brief Estado del echo */
+static uint8_t echo_state = kECHO_START;
+
+/** @brief Tick del primer echo, referencia de las estadísticas de inicio */
+static uint32_t startup_tickstart;
+
+/** Para conteo de duración del echo y de espera hasta reenvío en estado kWAITING_ECHO_RESPONSE */
 static uint32_t tickstart;
 
+/** @brief Espera actual en ms hasta reenviar echo */
+static uint32_t echo_retry_ms;
+
+/** @brief Variable de confirmación de cada módulo en el bus de recepción CAN */
+static const uint8_t *const startup_module_ok[kSTARTUP_MODULE_COUNT] =
+{
+	[kSTARTUP_MODULE_BMS]			= &bus_can_input.bms_ok,
+	[kSTARTUP_MODULE_DCDC]			= &bus_can_input.dcdc_ok,
+	[kSTARTUP_MODULE_INVERSOR]		= &bus_can_input.inversor_ok,
+	[kSTARTUP_MODULE_PERIFERICOS]	= &bus_can_input.perifericos_ok,
+};
+
+/** @brief Estadísticas del handshake de inicio */
+static app_startup_stats_t startup_stats;
+
+#if RAMFUNC_ENABLED == 1
+/** @brief Copia en SRAM de la tabla de vectores (VTOR requiere alineación a potencia de 2 >= su tamaño) */
+static uint32_t ram_vector_table[VECTOR_TABLE_SIZE] __attribute__((aligned(512)));
+#endif /* RAMFUNC_ENABLED */
+
 /***********************************************************************************************************************
  * Private functions prototypes
  **********************************************************************************************************************/
 
-static void MX_APP_Send_Echo(typedef_bus2_t* bus_can_output);
+static void MX_APP_Wait_EchoResponse(void);
+static void MX_APP_Update_ModulesAck(uint32_t now_ms);
+static void MX_APP_Send_Echo(typedef_bus2_t* bus_can_output, uint32_t now_ms);
+#if RAMFUNC_ENABLED == 1
+static void MX_APP_Relocate_VectorTable(void);
+#endif /* RAMFUNC_ENABLED */
 
 /***********************************************************************************************************************
  * Public functions implementation
@@ -65,6 +111,14 @@ static void MX_APP_Send_Echo(typedef_bus2_t* bus_can_output);
 
 void MX_APP_Init(void)
 {
+#if RAMFUNC_ENABLED == 1
+    /* Vector table in SRAM, so RAMFUNC interrupts do not fetch from flash */
+    MX_APP_Relocate_VectorTable();
+#endif /* RAMFUNC_ENABLED */
+
+    /* Initialize execution time measurement (DWT cycle counter) */
+    PROFILING_Init();
+
     /* Initialize board LEDs */
     BSP_LED_Init(LED1);
     BSP_LED_Init(LED2);
@@ -76,21 +130,16 @@ void MX_APP_Init(void)
     /* Initialize hardware */
     CAN_HW_Init();
 
-    /* Indicate that initialization was completed */
-    for(int i=0; i<3; i++)
-    {
-    	BSP_LED_On(LED1);
-    	BSP_LED_On(LED2);
-    	BSP_LED_On(LED3);
+    /* Load default pedal map */
+    RAMPA_PEDAL_Init();
 
-    	HAL_Delay(200);
+    /* Indicate that initialization was completed (LED pattern, non-blocking) */
+    INDICATORS_Init();
 
-    	BSP_LED_Off(LED1);
-    	BSP_LED_Off(LED2);
-    	BSP_LED_Off(LED3);
-
-    	HAL_Delay(200);
-    }
+#ifdef DEBUG
+    /* Keep debugger connection while the core sleeps in WFI (SCHEDULER_Idle) */
+    HAL_DBGMCU_EnableDBGSleepMode();
+#endif /* DEBUG */
 }
 
 void MX_APP_Process(void)
@@ -101,87 +150,206 @@ void MX_APP_Process(void)
 	/* Estado esperando respuesta ECHO a tarjetas: BMS, DCDC, Inversor, Perifericos */
 	case kWAITING_ECHO_RESPONSE:
 
+		/* Echo, confirmación de cada módulo y reenvío de echo, sin bloquear */
+		MX_APP_Wait_EchoResponse();
+
+		break;
+
+	/* Estado tarjeta de Control running */
+	case kRUNNING:
+
+		/* Tareas periódicas: CAN, decodificación, monitoreo, fallas, modos de manejo, rampa pedal e indicadores */
+		SCHEDULER_Process();
+
+		break;
+	}
+
+	/* Duerme hasta la siguiente interrupción si no hay tareas liberadas */
+	SCHEDULER_Idle();
+}
+
+/**
+ * @brief Estadísticas del handshake de inicio (echo).
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param None
+ * @return const app_startup_stats_t* Estadísticas de inicio
+ */
+const app_startup_stats_t *MX_APP_Get_StartupStats(void)
+{
+	return &startup_stats;
+}
+
+/***********************************************************************************************************************
+ * Private functions implementation
+ **********************************************************************************************************************/
+
+
+/**
+ * @brief Espera no bloqueante de la respuesta al echo de BMS, DCDC, Inversor y Periféricos.
+ *
+ * La confirmación de cada módulo se registra por separado en cuanto se recibe, por lo que un
+ * módulo que ya confirmó no necesita confirmar de nuevo. Mientras falte algún módulo, el echo se
+ * reenvía con una espera que se duplica en cada reintento, desde ECHO_RETRY_MIN_MS hasta
+ * TIMEOUT_VALUE_MS. Con la confirmación del último módulo, Control pasa a kRUNNING.
+ *
+ * La tarea CAN del planificador recién corre en kRUNNING, por lo que cada pasada del handshake
+ * llama a CAN_HW_Process: sin ella un bus-off durante el handshake no se recupera
+ * (AutoBusOff deshabilitado) y los mensajes encolados no llegan a los mailboxes.
+ *
+ * @param None
+ * @retval None
+ */
+static void MX_APP_Wait_EchoResponse(void)
+{
+	uint32_t now_ms = HAL_GetTick();
+
+	if (echo_state == kECHO_START)
+	{
+		startup_tickstart = now_ms;
+		echo_retry_ms = ECHO_RETRY_MIN_MS;
+
 		/* Envía echo a demás tarjetas */
-		MX_APP_Send_Echo(&bus_can_output);
+		MX_APP_Send_Echo(&bus_can_output, now_ms);
+	}
 
-		/* Get ticks for timeout counting */
-		tickstart = HAL_GetTick();
+	/* Recuperación de bus-off y alimentación de mailboxes de transmisión */
+	CAN_HW_Process();
 
-		while(1)
-		{
-		    /* Recibió mensaje CAN */
-		    if (flag_rx_can == CAN_MSG_RECEIVED)
-		    {
-		        CAN_APP_Store_ReceivedMessage();
-
-		        flag_rx_can = CAN_MSG_NOT_RECEIVED;
-		    }
-
-			/* LEDs para indicar confirmación de cada módulo */
-			INDICATORS_Update_ModulesLEDs();
-
-			/* Si todos los módulos respondieron OK, Control está listo */
-			if (bus_can_input.bms_ok == CAN_VALUE_MODULE_OK &&
-                bus_can_input.dcdc_ok == CAN_VALUE_MODULE_OK &&
-                bus_can_input.inversor_ok == CAN_VALUE_MODULE_OK &&
-                bus_can_input.perifericos_ok == CAN_VALUE_MODULE_OK)
-			{
-				HAL_Delay(500);
+	/* Guarda mensajes CAN recibidos */
+	CAN_APP_Receive_Messages();
 
-				/* Send control_ok MODULE_OK response */
-				bus_can_output.control_ok = CAN_VALUE_MODULE_OK;
-				CAN_APP_Send_BusData(&bus_can_output);
+	/* Registra la confirmación de cada módulo */
+	MX_APP_Update_ModulesAck(now_ms);
 
-				/* Indicate that start up has finished */
-				INDICATORS_Finish_StartUp();
+	/* LEDs para indicar confirmación de cada módulo */
+	INDICATORS_Update_ModulesLEDs();
 
-				app_state = kRUNNING;
+	/* Si todos los módulos respondieron OK, Control está listo */
+	if (startup_stats.acked_modules == STARTUP_ALL_MODULES)
+	{
+		startup_stats.ready = true;
+		startup_stats.time_to_ready_ms = now_ms - startup_tickstart;
 
-				break;
-			}
-			else if((HAL_GetTick() - tickstart) > TIMEOUT_VALUE_MS)
-			{
-				/* Envía echo a demás tarjetas, de nuevo */
-				MX_APP_Send_Echo(&bus_can_output);
+		/* Send control_ok MODULE_OK response */
+		bus_can_output.control_ok = CAN_VALUE_MODULE_OK;
+		CAN_APP_Send_BusData(&bus_can_output);
 
-				tickstart = HAL_GetTick();
-			}
-		}
+		/* Indicate that start up has finished */
+		INDICATORS_Finish_StartUp();
 
-		break;
+		/* Primera liberación de las tareas periódicas */
+		SCHEDULER_Init();
 
-	/* Estado tarjeta de Control running */
-	case kRUNNING:
+		app_state = kRUNNING;
 
-		CAN_APP_Process();
+		return;
+	}
 
-		DECODE_DATA_Process();
+	switch (echo_state)
+	{
 
-		MONITORING_Process();
+	/* Fin del echo */
+	case kECHO_PULSE:
 
-		FAILURES_Process();
+		if ((now_ms - tickstart) >= ECHO_LENGTH_MS)
+		{
+			bus_can_output.control_ok = CAN_VALUE_MODULE_IDLE;
+			CAN_APP_Send_BusData(&bus_can_output);
 
-		DRIVING_MODES_Process();
+			tickstart = now_ms;
+			echo_state = kECHO_WAIT;
+		}
 
-		RAMPA_PEDAL_Process();
+		break;
+
+	/* Reenvío de echo, con espera creciente */
+	case kECHO_WAIT:
+
+		if ((now_ms - tickstart) >= echo_retry_ms)
+		{
+			/* Envía echo a demás tarjetas, de nuevo */
+			MX_APP_Send_Echo(&bus_can_output, now_ms);
 
-	    INDICATORS_Process();
+			echo_retry_ms *= 2U;
+
+			if (echo_retry_ms > TIMEOUT_VALUE_MS)
+			{
+				echo_retry_ms = TIMEOUT_VALUE_MS;
+			}
+		}
 
 		break;
 	}
 }
 
-/***********************************************************************************************************************
- * Private functions implementation
- **********************************************************************************************************************/
+/**
+ * @brief Registra la confirmación (MODULE_OK) de los módulos que aún no habían confirmado.
+ *
+ * @param now_ms Tick actual [ms]
+ * @retval None
+ */
+static void MX_APP_Update_ModulesAck(uint32_t now_ms)
+{
+	for (uint32_t i = 0; i < kSTARTUP_MODULE_COUNT; i++)
+	{
+		uint32_t mask = 1UL << i;
 
-static void MX_APP_Send_Echo(typedef_bus2_t* bus_can_output)
+		if (((startup_stats.acked_modules & mask) == 0U) && (*startup_module_ok[i] == CAN_VALUE_MODULE_OK))
+		{
+			startup_stats.acked_modules |= mask;
+			startup_stats.ack_ms[i] = now_ms - startup_tickstart;
+		}
+	}
+}
+
+/**
+ * @brief Inicia un echo: control_ok en MODULE_OK durante ECHO_LENGTH_MS.
+ *
+ * El fin del echo (control_ok en MODULE_IDLE) lo envía MX_APP_Wait_EchoResponse.
+ *
+ * @param bus_can_output Puntero a estructura de tipo typedef_bus2_t (bus de salida CAN)
+ * @param now_ms Tick actual [ms]
+ * @retval None
+ */
+static void MX_APP_Send_Echo(typedef_bus2_t* bus_can_output, uint32_t now_ms)
 {
 	bus_can_output->control_ok = CAN_VALUE_MODULE_OK;
 	CAN_APP_Send_BusData(bus_can_output);
 
-	HAL_Delay(ECHO_LENGTH_MS);
+	startup_stats.echoes++;
 
-	bus_can_output->control_ok = CAN_VALUE_MODULE_IDLE;
-	CAN_APP_Send_BusData(bus_can_output);
+	tickstart = now_ms;
+	echo_state = kECHO_PULSE;
+}
+
+#if RAMFUNC_ENABLED == 1
+/**
+ * @brief Copia la tabla de vectores a SRAM y la activa.
+ *
+ * La entrada a una interrupción lee su vector de la tabla; con la tabla en flash, las
+ * interrupciones ubicadas en SRAM (RAMFUNC) también se detendrían durante un borrado o una
+ * escritura de flash.
+ *
+ * @param None
+ * @retval None
+ */
+static void MX_APP_Relocate_VectorTable(void)
+{
+	const uint32_t *flash_vector_table = (const uint32_t *)SCB->VTOR;
+	uint32_t primask = __get_PRIMASK();
+
+	for (uint32_t i = 0; i < VECTOR_TABLE_SIZE; i++)
+	{
+		ram_vector_table[i] = flash_vector_table[i];
+	}
+
+	__disable_irq();
+
+	SCB->VTOR = (uint32_t)ram_vector_table;
+	__DSB();
+
+	__set_PRIMASK(primask);
 }
+#endif /* RAMFUNC_ENABLED */
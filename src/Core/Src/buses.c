@@ -49,6 +49,9 @@ typedef_bus1_t bus_data =
 	.bms_status = kMODULE_STATUS_DATA_PROBLEM,
 	.dcdc_status = kMODULE_STATUS_DATA_PROBLEM,
 	.inversor_status = kMODULE_STATUS_DATA_PROBLEM,
+
+	/* Ninguna variable del bus de entrada CAN se ha recibido */
+	.stale_signals = RX_SIGNAL_ALL_MASK,
 };
 
 /* Inicialización de bus de salida CAN (bus 2) */
@@ -22,6 +22,12 @@
 
 /* USER CODE BEGIN 0 */
 
+/** @brief Tasa de bits CAN [bit/s] */
+#define CAN1_BITRATE                250000U
+
+/** @brief Time quanta por bit: sync (1) + BS1 (5) + BS2 (4), punto de muestreo 60 % */
+#define CAN1_TQ_PER_BIT             (1U + 5U + 4U)
+
 /* USER CODE END 0 */
 
 CAN_HandleTypeDef hcan1;
@@ -36,6 +42,7 @@ void MX_CAN1_Init(void)
 
   /* USER CODE BEGIN CAN1_Init 1 */
 
+
   /* USER CODE END CAN1_Init 1 */
   hcan1.Instance = CAN1;
   hcan1.Init.Prescaler = 16;
@@ -55,6 +62,26 @@ void MX_CAN1_Init(void)
   }
   /* USER CODE BEGIN CAN1_Init 2 */
 
+  /* Prescaler from the APB1 clock of the selected clock profile (CLOCK_PROFILE). Control.ioc
+     describes the low-power profile; any other profile re-initializes the bit timing here so
+     that CubeMX regeneration keeps it */
+  uint32_t can_prescaler = HAL_RCC_GetPCLK1Freq() / (CAN1_BITRATE * CAN1_TQ_PER_BIT);
+
+  /* The bit rate must be exact */
+  if (HAL_RCC_GetPCLK1Freq() != can_prescaler * CAN1_BITRATE * CAN1_TQ_PER_BIT)
+  {
+    Error_Handler();
+  }
+
+  if (hcan1.Init.Prescaler != can_prescaler)
+  {
+    hcan1.Init.Prescaler = can_prescaler;
+    if (HAL_CAN_Init(&hcan1) != HAL_OK)
+    {
+      Error_Handler();
+    }
+  }
+
   /* USER CODE END CAN1_Init 2 */
 
 }
@@ -84,8 +111,14 @@ void HAL_CAN_MspInit(CAN_HandleTypeDef* canHandle)
     HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
 
     /* CAN1 interrupt Init */
-    HAL_NVIC_SetPriority(CAN1_RX0_IRQn, 0, 0);
+    HAL_NVIC_SetPriority(CAN1_TX_IRQn, 1, 0);
+    HAL_NVIC_EnableIRQ(CAN1_TX_IRQn);
+    HAL_NVIC_SetPriority(CAN1_RX0_IRQn, 1, 0);
     HAL_NVIC_EnableIRQ(CAN1_RX0_IRQn);
+    HAL_NVIC_SetPriority(CAN1_RX1_IRQn, 0, 0);
+    HAL_NVIC_EnableIRQ(CAN1_RX1_IRQn);
+    HAL_NVIC_SetPriority(CAN1_SCE_IRQn, 2, 0);
+    HAL_NVIC_EnableIRQ(CAN1_SCE_IRQn);
   /* USER CODE BEGIN CAN1_MspInit 1 */
 
   /* USER CODE END CAN1_MspInit 1 */
@@ -110,7 +143,10 @@ void HAL_CAN_MspDeInit(CAN_HandleTypeDef* canHandle)
     HAL_GPIO_DeInit(GPIOA, GPIO_PIN_11|GPIO_PIN_12);
 
     /* CAN1 interrupt Deinit */
+    HAL_NVIC_DisableIRQ(CAN1_TX_IRQn);
     HAL_NVIC_DisableIRQ(CAN1_RX0_IRQn);
+    HAL_NVIC_DisableIRQ(CAN1_RX1_IRQn);
+    HAL_NVIC_DisableIRQ(CAN1_SCE_IRQn);
   /* USER CODE BEGIN CAN1_MspDeInit 1 */
 
   /* USER CODE END CAN1_MspDeInit 1 */
@@ -15,32 +15,160 @@
 
 #include "can_app.h"
 
+#include "app_control.h"
+#include "profiling.h"
+#include "ram_monitor.h"
+#include "rampa_pedal.h"
+
 /***********************************************************************************************************************
  * Private macros
  **********************************************************************************************************************/
 
-/** @brief CAN number of messages to transmit */
-#define CAN_NUM_OF_MSGS                 6
+/** @brief Tamaño de tabla de despacho de recepción (IDs 0x000 a 0x04F) */
+#define CAN_RX_DISPATCH_SIZE            0x050
+
+/** @brief Contador de eventos saturado a 8 bits, para frames de diagnóstico */
+#define CAN_DIAG_SAT8(count)            ((uint8_t)(((count) > 0xFFU) ? 0xFFU : (count)))
+
+/** @brief Valor saturado a 16 bits, para frames de diagnóstico */
+#define CAN_DIAG_SAT16(value)           ((uint16_t)(((value) > 0xFFFFU) ? 0xFFFFU : (value)))
+
+/** @brief Edad máxima de una variable del bus de entrada CAN, en periodos de transmisión esperados */
+#define CAN_RX_TIMEOUT_PERIODS          3U
+
+/** @brief Entrada de tabla de despacho para una variable del bus de entrada CAN */
+#define CAN_RX_ENTRY(field, signal)     {offsetof(typedef_bus3_t, field), sizeof(((typedef_bus3_t *)0)->field), 1UL << (signal)}
+
+/** @brief Entrada de tabla de despacho para un frame empaquetado (num_of_signals variables contiguas desde field) */
+#define CAN_RX_PACKED_ENTRY(field, signal, num_of_signals) \
+    {offsetof(typedef_bus3_t, field), num_of_signals, ((1UL << (num_of_signals)) - 1UL) << (signal)}
+
+/***********************************************************************************************************************
+ * Private types declarations
+ **********************************************************************************************************************/
+
+/**
+ * @brief Entrada de tabla de despacho de recepción CAN
+ *
+ */
+typedef struct
+{
+    uint8_t offset;     /**< Offset de la variable en typedef_bus3_t */
+    uint8_t width;      /**< Bytes del payload a copiar (0: ID no se usa) */
+    uint32_t signals;   /**< Bits de las variables en can_rx_dirty_signals */
+} can_rx_dispatch_t;
 
 /***********************************************************************************************************************
  * Private variables definitions
  **********************************************************************************************************************/
 
-/** @brief Array of CAN IDs to transmit */
-static const uint32_t can_ids_array[CAN_NUM_OF_MSGS] = {CAN_ID_CONTROL_AUTOKILL,
-                                                        CAN_ID_CONTROL_ESTADO_MANEJO,
-                                                        CAN_ID_CONTROL_ESTADO_FALLA,
-                                                        CAN_ID_CONTROL_NIVEL_VELOCIDAD,
-                                                        CAN_ID_CONTROL_HOMBRE_MUERTO,
-                                                        CAN_ID_CONTROL_OK};
+#define CAN_RX_DISPATCH(module, id_name, id, dir, fifo, field, type, decode, dest, scale, offset, period_ms) \
+    CAN_SIGNAL_IF_LEGACY(module, CAN_SIGNAL_IF_RX(dir, [CAN_ID_##id_name] = CAN_RX_ENTRY(field, kRX_SIGNAL_##id_name),))
 
-/** @brief Array of CAN values to transmit */
-static uint8_t can_values_array[CAN_NUM_OF_MSGS];
+#define CAN_RX_PACKED_DISPATCH(module, id_name, id, dir, fifo, first_id_name, first_field) \
+    CAN_SIGNAL_IF_PACKED(module, CAN_SIGNAL_IF_RX(dir, [CAN_ID_##id_name] = \
+        CAN_RX_PACKED_ENTRY(first_field, kRX_SIGNAL_##first_id_name, CAN_MODULE_NUM_OF_SIGNALS(module, RX)),))
+
+/** @brief Tabla de despacho de recepción CAN, indexada directamente por standard identifier */
+static const can_rx_dispatch_t can_rx_dispatch_table[CAN_RX_DISPATCH_SIZE] =
+{
+    CAN_SIGNALS(CAN_RX_DISPATCH)
+
+    CAN_PACKED_FRAMES(CAN_RX_PACKED_DISPATCH)
+};
+
+#undef CAN_RX_DISPATCH
+#undef CAN_RX_PACKED_DISPATCH
+
+#define CAN_RX_PACKED_ASSERT(module, id_name, id, dir, fifo, first_id_name, first_field) \
+    _Static_assert(CAN_MODULE_NUM_OF_SIGNALS(module, dir) <= PAYLOAD_MAX_LENGTH, \
+                   "Las señales de " #module " no caben en un frame empaquetado"); \
+    CAN_SIGNAL_IF_PACKED(module, _Static_assert(CAN_MODULE_SIZE(module, dir) == CAN_MODULE_NUM_OF_SIGNALS(module, dir), \
+                   "Los frames empaquetados de " #module " asumen variables de 1 byte");)
+
+CAN_PACKED_FRAMES(CAN_RX_PACKED_ASSERT)
+
+#undef CAN_RX_PACKED_ASSERT
+
+_Static_assert(kRX_SIGNAL_COUNT <= 32, "can_rx_dirty_signals tiene un bit por variable del bus de entrada CAN");
+
+#define CAN_RX_MAX_AGE(module, id_name, id, dir, fifo, field, type, decode, dest, scale, offset, period_ms) \
+    CAN_SIGNAL_IF_RX(dir, [kRX_SIGNAL_##id_name] = CAN_RX_TIMEOUT_PERIODS * (period_ms),)
+
+/** @brief Edad máxima [ms] de cada variable del bus de entrada CAN antes de considerarse vencida */
+static const uint32_t can_rx_max_age_ms[kRX_SIGNAL_COUNT] =
+{
+    CAN_SIGNALS(CAN_RX_MAX_AGE)
+};
+
+#undef CAN_RX_MAX_AGE
+
+#define CAN_DIAG_FRAME(id_name, id, period_ms) \
+    kDIAG_FRAME_##id_name,
+
+/** @brief Índice de cada frame de diagnóstico */
+typedef enum
+{
+    CAN_DIAG_FRAMES(CAN_DIAG_FRAME)
+
+    kDIAG_FRAME_COUNT
+} can_diag_frame_t;
+
+#undef CAN_DIAG_FRAME
+
+#define CAN_DIAG_PERIOD(id_name, id, period_ms) \
+    [kDIAG_FRAME_##id_name] = (period_ms) / CAN_TX_SLOT_MS,
+
+/** @brief Periodo de cada frame de diagnóstico, en slots de transmisión */
+static const uint32_t can_diag_period_slots[kDIAG_FRAME_COUNT] =
+{
+    CAN_DIAG_FRAMES(CAN_DIAG_PERIOD)
+};
+
+#undef CAN_DIAG_PERIOD
+
+/** @brief Slot de transmisión de la última transmisión de cada frame de diagnóstico */
+static uint32_t can_diag_slots[kDIAG_FRAME_COUNT];
+
+/** @brief Tick [ms] de la última recepción de cada variable del bus de entrada CAN */
+static uint32_t can_rx_timestamps[kRX_SIGNAL_COUNT];
+
+/** @brief Tiempo [us] de recepción del último frame que cambió el valor de cada variable del bus de entrada CAN */
+static uint32_t can_rx_change_us[kRX_SIGNAL_COUNT];
+
+/** @brief Máscara de variables del bus de entrada CAN recibidas al menos una vez */
+static uint32_t can_rx_received_signals = 0;
+
+/***********************************************************************************************************************
+ * Global variables definitions
+ **********************************************************************************************************************/
+
+/** @brief Máscara de variables del bus de entrada CAN con valor nuevo, pendientes de decodificar (un bit por rx_signal_t) */
+uint32_t can_rx_dirty_signals = 0;
 
 /***********************************************************************************************************************
  * Private functions prototypes
  **********************************************************************************************************************/
 
+static uint32_t CAN_APP_Get_StaleSignals(void);
+
+static void CAN_APP_Send_DiagFrame(can_diag_frame_t frame);
+
+static void CAN_APP_Build_DiagCan(uint8_t *payload);
+
+static void CAN_APP_Build_DiagCanTx(uint8_t *payload);
+
+static void CAN_APP_Build_DiagAutokill(uint8_t *payload);
+static void CAN_APP_Build_DiagStartup(uint8_t *payload);
+static void CAN_APP_Build_DiagCpu(uint8_t *payload);
+#if PROFILING_ENABLED == 1
+static void CAN_APP_Build_DiagProfiling(uint8_t *payload);
+#endif /* PROFILING_ENABLED */
+static void CAN_APP_Build_DiagRam(uint8_t *payload);
+static void CAN_APP_Build_DiagRampa(uint8_t *payload);
+
+static void CAN_APP_Put_U16(uint8_t *payload, uint16_t value);
+
 /***********************************************************************************************************************
  * Public functions implementation
  **********************************************************************************************************************/
@@ -49,8 +177,9 @@ static uint8_t can_values_array[CAN_NUM_OF_MSGS];
  * @brief Función principal de CAN a nivel de aplicación.
  *
  * Guarda mensaje CAN recibido en bus de entrada CAN cuando se activa
- * bandera de recepción. Envía datos de bus de salida CAN cuando se
- * activa bandera de transmisión.
+ * bandera de recepción. Transmite los cambios del bus de salida CAN y
+ * sus heartbeats, y en cada slot de transmisión (TIM7) los frames de
+ * diagnóstico.
  *
  * No es static, por lo que puede ser usada por otros archivos.
  *
@@ -59,53 +188,46 @@ static uint8_t can_values_array[CAN_NUM_OF_MSGS];
  */
 void CAN_APP_Process(void)
 {
-	/** Increments every time CAN TX flag is set as CAN_TX_READY */
-	static int can_tx_flag_count = 0;
+	/** Último slot de transmisión procesado */
+	static uint32_t can_tx_last_slot = 0;
 
-    /* Recibió mensaje CAN */
-    if (flag_rx_can == CAN_MSG_RECEIVED)
-    {
-		/* Toggle LED 2 (Red LED) */
-		BSP_LED_Toggle(LED2);
+	uint32_t slot_count = can_tx_slot_count;
 
-        /* Guarda mensaje CAN recibido en bus de entrada CAN */
-        CAN_APP_Store_ReceivedMessage();
+    /* Supervisión de errores y recuperación de bus-off */
+    CAN_HW_Process();
 
-        /* Clear CAN received message flag */
-        flag_rx_can = CAN_MSG_NOT_RECEIVED;
+    /* Guarda todos los mensajes CAN recibidos en bus de entrada CAN (marca las variables con valor nuevo) */
+    (void)CAN_APP_Receive_Messages();
 
-        /* Activa bandera para decodificar */
-        flag_decodificar = DECODIFICA;
-    }
+    /* Actualiza variables del bus de entrada CAN vencidas */
+    bus_data.stale_signals = CAN_APP_Get_StaleSignals();
 
-    /* Hubo trigger para transmisión mensaje CAN */
-    if (flag_tx_can == CAN_TX_READY)
-    {
-    	/* Incrementa contador de bandera transmisión CAN */
-    	can_tx_flag_count++;
+    /* Frames de salida con cambios de valor o sin transmitir por su máximo silencio */
+    CAN_TX_Process(HAL_GetTick());
 
-    	/* Send bus variables every 500ms (CAN transmission timer is set to 100ms) */
-    	if(can_tx_flag_count % 5 == 0)
+    /* Hubo uno o más slots de transmisión CAN (TIM7) desde la última pasada */
+    if (slot_count != can_tx_last_slot)
+    {
+    	/* Frames de diagnóstico */
+    	for (uint32_t i = 0; i < kDIAG_FRAME_COUNT; i++)
     	{
-    		/* Toggle LED 1 (Red LED) */
-    		BSP_LED_Toggle(LED1);
-
-			/* Envío de datos del bus de salida CAN a módulo CAN */
-			CAN_APP_Send_BusData(&bus_can_output);
+    		if ((slot_count - can_diag_slots[i]) >= can_diag_period_slots[i])
+    		{
+    			CAN_APP_Send_DiagFrame((can_diag_frame_t)i);
 
-			/* Better reset this to zero */
-			can_tx_flag_count = 0;
+    			can_diag_slots[i] = slot_count;
+    		}
     	}
 
-        /* Clear CAN TX ready flag */
-        flag_rx_can = CAN_TX_NOT_READY;
+        can_tx_last_slot = slot_count;
     }
 }
 
 /**
  * @brief Función de envío de datos de bus de salida CAN a módulo CAN.
  *
- * Realiza el envío de las variables que se encuentran en el bus de salida CAN a módulo CAN.
+ * Realiza el envío inmediato de todos los frames de salida (fuera del planificador de
+ * transmisión), por ejemplo para el eco de inicio.
  *
  * No es static, por lo que puede ser usada por otros archivos.
  *
@@ -114,139 +236,403 @@ void CAN_APP_Process(void)
  */
 void CAN_APP_Send_BusData(typedef_bus2_t *bus_can_output)
 {
-	/* Index for CAN values array and CAN IDs array */
-	static int i = 0;
+	CAN_TX_Send_All(bus_can_output);
+}
 
-	/* Bus data into CAN values array */
-	can_values_array[0] = bus_can_output->autokill;
-	can_values_array[1] = bus_can_output->estado_manejo;
-	can_values_array[2] = bus_can_output->estado_falla;
-	can_values_array[3] = bus_can_output->nivel_velocidad;
-	can_values_array[4] = bus_can_output->hombre_muerto;
-	can_values_array[5] = bus_can_output->control_ok;
+/**
+ * @brief Función de recepción de todos los mensajes CAN pendientes.
+ *
+ * Vacía el buffer de recepción CAN, guardando cada mensaje en el bus de entrada CAN.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param None
+ * @return uint32_t Número de mensajes procesados
+ */
+uint32_t CAN_APP_Receive_Messages(void)
+{
+	can_frame_t frame;
+	uint32_t count = 0;
 
-	/* Index exceeds number of messages to transmit */
-	if(i >= CAN_NUM_OF_MSGS)
+	while (CAN_HW_Get_ReceivedFrame(&frame))
 	{
-		i=0;
-		return;
-	}
+		CAN_APP_Store_ReceivedMessage(&frame);
 
-	/* Set up can_obj for message transmission */
-	can_obj.Frame.id = can_ids_array[i];
-	can_obj.Frame.payload_length = 1;
-	can_obj.Frame.payload_buff[0] = can_values_array[i];
-
-	/* Send message */
-	if (CAN_API_Send_Message(&can_obj) != CAN_STATUS_OK)
-	{
-		Error_Handler();
+		count++;
 	}
 
-	i++;
+	return count;
 }
 
 /**
  * @brief Función guardar mensaje CAN recibido en bus de entrada CAN.
  *
  * Según standard identifier que se recibió, guarda dato en variables de bus de recepción CAN.
+ * El destino se obtiene de una tabla indexada por el identifier, por lo que el costo es
+ * constante sin importar el número de variables. Un frame empaquetado se copia completo a
+ * las variables contiguas de su módulo. Cada variable actualizada se marca con el tick de
+ * recepción, y las que cambian de valor se marcan en can_rx_dirty_signals para que
+ * DECODE_DATA_Process solo decodifique esas, y con el tiempo [us] de recepción del frame
+ * (ver CAN_APP_Get_SignalChangeUs).
  *
  * No es static, por lo que puede ser usada por otros archivos.
  *
- * @param None
+ * @param frame Puntero a mensaje CAN recibido
  * @retval None
  */
-void CAN_APP_Store_ReceivedMessage(void)
+void CAN_APP_Store_ReceivedMessage(const can_frame_t *frame)
 {
-    switch (can_obj.Frame.id)
+    const can_rx_dispatch_t *entry;
+    uint8_t *dest;
+    uint32_t first_signal;
+    uint32_t dirty;
+    uint32_t changed = 0U;
+    uint32_t signals;
+    uint32_t now;
+    uint8_t width;
+
+    if (frame->id >= CAN_RX_DISPATCH_SIZE)
     {
+        return;
+    }
 
-    /* ------------------------------ Periféricos ------------------------------ */
+    entry = &can_rx_dispatch_table[frame->id];
 
-    case CAN_ID_PERIFERICOS_PEDAL:
-        bus_can_input.pedal = can_obj.Frame.payload_buff[0];
-        break;
-    case CAN_ID_PERIFERICOS_HOMBRE_MUERTO:
-        bus_can_input.hombre_muerto = can_obj.Frame.payload_buff[0];
-        break;
-    case CAN_ID_PERIFERICOS_BOTONES_CAMBIO_ESTADO:
-        bus_can_input.botones_cambio_estado = can_obj.Frame.payload_buff[0];
-        break;
-    case CAN_ID_PERIFERICOS_OK:
-        bus_can_input.perifericos_ok = can_obj.Frame.payload_buff[0];
-        break;
+    if (entry->width == 0U)
+    {
+        return;
+    }
 
-    /* ---------------------------------- BMS ---------------------------------- */
+    /* Un frame más corto que lo esperado solo actualiza los bytes recibidos */
+    width = (frame->payload_length < entry->width) ? frame->payload_length : entry->width;
 
-    case CAN_ID_BMS_VOLTAJE:
-        bus_can_input.voltaje_bms = can_obj.Frame.payload_buff[0];
-        break;
-    case CAN_ID_BMS_CORRIENTE:
-        bus_can_input.corriente_bms = can_obj.Frame.payload_buff[0];
-        break;
-    case CAN_ID_BMS_VOLTAJE_MIN_CELDA:
-        bus_can_input.voltaje_min_celda_bms = can_obj.Frame.payload_buff[0];
-        break;
-    case CAN_ID_BMS_POTENCIA:
-        bus_can_input.potencia_bms = can_obj.Frame.payload_buff[0];
-        break;
-    case CAN_ID_BMS_T_MAX:
-        bus_can_input.t_max_bms = can_obj.Frame.payload_buff[0];
-        break;
-    case CAN_ID_BMS_NIVEL_BATERIA:
-        bus_can_input.nivel_bateria_bms = can_obj.Frame.payload_buff[0];
-        break;
-    case CAN_ID_BMS_OK:
-        bus_can_input.bms_ok = can_obj.Frame.payload_buff[0];
-        break;
+    dest = (uint8_t *)&bus_can_input + entry->offset;
 
-    /* --------------------------------- DCDC ---------------------------------- */
+    /* Las variables recibidas por primera vez se decodifican aunque su valor sea el inicial */
+    dirty = entry->signals & ~can_rx_received_signals;
 
-    case CAN_ID_DCDC_VOLTAJE_BATERIA:
-        bus_can_input.voltaje_bateria_dcdc = can_obj.Frame.payload_buff[0];
-        break;
-    case CAN_ID_DCDC_VOLTAJE_SALIDA:
-        bus_can_input.voltaje_salida_dcdc = can_obj.Frame.payload_buff[0];
-        break;
-    case CAN_ID_DCDC_T_MAX:
-        bus_can_input.t_max_dcdc = can_obj.Frame.payload_buff[0];
-        break;
-    case CAN_ID_DCDC_POTENCIA:
-        bus_can_input.potencia_dcdc = can_obj.Frame.payload_buff[0];
-        break;
-    case CAN_ID_DCDC_OK:
-        bus_can_input.dcdc_ok = can_obj.Frame.payload_buff[0];
-        break;
+    for (uint32_t i = 0; i < width; i++)
+    {
+        if (dest[i] != frame->payload_buff[i])
+        {
+            dest[i] = frame->payload_buff[i];
+            changed |= 1UL << i;
+        }
+    }
+
+    if (changed != 0U)
+    {
+        /*
+         * Frame empaquetado: el byte i del payload es la variable first_signal + i. Frame de una
+         * variable: cualquier byte cambiado marca la variable (puede ocupar más de un byte)
+         */
+        first_signal = (uint32_t)__builtin_ctz(entry->signals);
+        dirty |= ((entry->signals & (entry->signals - 1U)) != 0U) ? (changed << first_signal) : entry->signals;
+    }
+
+    /* Marca de tiempo de recepción de cada variable actualizada */
+    now = HAL_GetTick();
+
+    for (signals = entry->signals; signals != 0U; signals &= signals - 1U)
+    {
+        can_rx_timestamps[__builtin_ctz(signals)] = now;
+    }
+
+    /* Tiempo de recepción del frame que cambió cada variable, solo si hubo cambio */
+    for (signals = dirty; signals != 0U; signals &= signals - 1U)
+    {
+        can_rx_change_us[__builtin_ctz(signals)] = frame->timestamp_us;
+    }
+
+    can_rx_received_signals |= entry->signals;
+    can_rx_dirty_signals |= dirty;
+}
+
+/**
+ * @brief Tiempo de recepción del último frame que cambió alguna de las variables indicadas.
+ *
+ * Punto de partida para medir la latencia desde la llegada de un dato hasta la reacción a
+ * él (por ejemplo, el frame express de autokill).
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param signals Máscara de variables del bus de entrada CAN (un bit por rx_signal_t)
+ * @return uint32_t Tiempo [us] (TIMEBASE_Get_TimeUs) del cambio más reciente, o el tiempo actual
+ *                  si ninguna de las variables ha cambiado
+ */
+uint32_t CAN_APP_Get_SignalChangeUs(uint32_t signals)
+{
+    uint32_t now_us = TIMEBASE_Get_TimeUs();
+    uint32_t change_us = now_us;
+    uint32_t min_age_us = UINT32_MAX;
+
+    signals &= can_rx_received_signals;
+
+    for (; signals != 0U; signals &= signals - 1U)
+    {
+        uint32_t signal_us = can_rx_change_us[__builtin_ctz(signals)];
+
+        if (now_us - signal_us < min_age_us)
+        {
+            min_age_us = now_us - signal_us;
+            change_us = signal_us;
+        }
+    }
+
+    return change_us;
+}
+
+/***********************************************************************************************************************
+ * Private functions implementation
+ **********************************************************************************************************************/
+
+/**
+ * @brief Obtiene las variables del bus de entrada CAN vencidas.
+ *
+ * Una variable está vencida si nunca se ha recibido o si su última recepción es más antigua
+ * que su edad máxima (CAN_RX_TIMEOUT_PERIODS veces su periodo esperado de transmisión). Es
+ * un solo recorrido sin saltos sobre los arreglos contiguos de marcas de tiempo y edades
+ * máximas, por lo que puede ejecutarse en cada pasada del loop principal.
+ *
+ * @param None
+ * @return uint32_t Máscara de variables vencidas (un bit por rx_signal_t)
+ */
+static uint32_t CAN_APP_Get_StaleSignals(void)
+{
+    uint32_t now = HAL_GetTick();
+    uint32_t stale_signals = ~can_rx_received_signals & RX_SIGNAL_ALL_MASK;
+
+    for (uint32_t i = 0; i < kRX_SIGNAL_COUNT; i++)
+    {
+        stale_signals |= (uint32_t)((now - can_rx_timestamps[i]) > can_rx_max_age_ms[i]) << i;
+    }
+
+    return stale_signals;
+}
 
-    /* -------------------------------- Inversor ------------------------------- */
+/**
+ * @brief Envía un frame de diagnóstico (ver can_def.h).
+ *
+ * @param frame Frame de diagnóstico
+ * @retval None
+ */
+static void CAN_APP_Send_DiagFrame(can_diag_frame_t frame)
+{
+    uint8_t payload[8] = {0};
+    uint32_t id;
 
-    case CAN_ID_INVERSOR_VELOCIDAD:
-        bus_can_input.velocidad_inv = can_obj.Frame.payload_buff[0];
+    switch (frame)
+    {
+    case kDIAG_FRAME_CONTROL_DIAG_CAN:
+        CAN_APP_Build_DiagCan(payload);
+        id = CAN_ID_CONTROL_DIAG_CAN;
         break;
-    case CAN_ID_INVERSOR_V:
-        bus_can_input.V_inv = can_obj.Frame.payload_buff[0];
+    case kDIAG_FRAME_CONTROL_DIAG_CAN_TX:
+        CAN_APP_Build_DiagCanTx(payload);
+        id = CAN_ID_CONTROL_DIAG_CAN_TX;
         break;
-    case CAN_ID_INVERSOR_I:
-        bus_can_input.I_inv = can_obj.Frame.payload_buff[0];
+    case kDIAG_FRAME_CONTROL_DIAG_AUTOKILL:
+        CAN_APP_Build_DiagAutokill(payload);
+        id = CAN_ID_CONTROL_DIAG_AUTOKILL;
         break;
-    case CAN_ID_INVERSOR_TEMP_MAX:
-        bus_can_input.temp_max_inv = can_obj.Frame.payload_buff[0];
+    case kDIAG_FRAME_CONTROL_DIAG_STARTUP:
+        CAN_APP_Build_DiagStartup(payload);
+        id = CAN_ID_CONTROL_DIAG_STARTUP;
         break;
-    case CAN_ID_INVERSOR_TEMP_MOTOR:
-        bus_can_input.temp_motor_inv = can_obj.Frame.payload_buff[0];
+    case kDIAG_FRAME_CONTROL_DIAG_CPU:
+        CAN_APP_Build_DiagCpu(payload);
+        id = CAN_ID_CONTROL_DIAG_CPU;
         break;
-    case CAN_ID_INVERSOR_POTENCIA:
-        bus_can_input.potencia_inv = can_obj.Frame.payload_buff[0];
+#if PROFILING_ENABLED == 1
+    case kDIAG_FRAME_CONTROL_DIAG_PROFILING:
+        CAN_APP_Build_DiagProfiling(payload);
+        id = CAN_ID_CONTROL_DIAG_PROFILING;
         break;
-    case CAN_ID_INVERSOR_OK:
-        bus_can_input.inversor_ok = can_obj.Frame.payload_buff[0];
+#endif /* PROFILING_ENABLED */
+    case kDIAG_FRAME_CONTROL_DIAG_RAM:
+        CAN_APP_Build_DiagRam(payload);
+        id = CAN_ID_CONTROL_DIAG_RAM;
         break;
-
-    default:
+    case kDIAG_FRAME_CONTROL_DIAG_RAMPA:
+        CAN_APP_Build_DiagRampa(payload);
+        id = CAN_ID_CONTROL_DIAG_RAMPA;
         break;
+    default:
+        return;
     }
+
+    (void)CAN_TX_Send_Frame(id, payload, sizeof(payload));
 }
 
-/***********************************************************************************************************************
- * Private functions implementation
- **********************************************************************************************************************/
+/**
+ * @brief Payload del frame de diagnóstico de errores CAN (CONTROL_DIAG_CAN, ver can_def.h).
+ *
+ * @param payload Payload de 8 bytes
+ * @retval None
+ */
+static void CAN_APP_Build_DiagCan(uint8_t *payload)
+{
+    const can_error_stats_t *stats = CAN_HW_Get_ErrorStats();
+    uint32_t rx_lost = stats->rx_fifo_overrun[RX_FIFO_0] + stats->rx_fifo_overrun[RX_FIFO_1]
+                     + CAN_HW_Get_RxOverflowCount(RX_FIFO_0) + CAN_HW_Get_RxOverflowCount(RX_FIFO_1);
+
+    payload[0] = stats->tec;
+    payload[1] = stats->rec;
+    payload[2] = (uint8_t)((stats->error_flags & (CAN_ESR_EWGF | CAN_ESR_EPVF | CAN_ESR_BOFF))
+                           | ((uint32_t)stats->last_error_code << 4));
+    payload[3] = CAN_DIAG_SAT8(stats->bus_off);
+    payload[4] = CAN_DIAG_SAT8(stats->error_passive);
+    payload[5] = CAN_DIAG_SAT8(stats->bus_errors);
+    payload[6] = CAN_DIAG_SAT8(rx_lost);
+    payload[7] = CAN_DIAG_SAT8(CAN_TX_Get_ErrorCount());
+}
+
+/**
+ * @brief Payload del frame de diagnóstico de la cola de transmisión CAN (CONTROL_DIAG_CAN_TX, ver can_def.h).
+ *
+ * @param payload Payload de 8 bytes
+ * @retval None
+ */
+static void CAN_APP_Build_DiagCanTx(uint8_t *payload)
+{
+    const can_tx_queue_stats_t *stats = CAN_HW_Get_TxQueueStats();
+    uint32_t sent = stats->sent;
+
+    payload[0] = CAN_DIAG_SAT8(stats->depth);
+    payload[1] = CAN_DIAG_SAT8(stats->high_water);
+    CAN_APP_Put_U16(&payload[2], CAN_DIAG_SAT16(stats->drops));
+    CAN_APP_Put_U16(&payload[4], CAN_DIAG_SAT16(stats->latency_max_us));
+    CAN_APP_Put_U16(&payload[6], CAN_DIAG_SAT16((sent > 0U) ? stats->latency_sum_us / sent : 0U));
+}
+
+/**
+ * @brief Payload del frame de diagnóstico del camino express de autokill (CONTROL_DIAG_AUTOKILL, ver can_def.h).
+ *
+ * @param payload Payload de 8 bytes
+ * @retval None
+ */
+static void CAN_APP_Build_DiagAutokill(uint8_t *payload)
+{
+    const can_express_stats_t *stats = CAN_HW_Get_ExpressStats();
+
+    CAN_APP_Put_U16(&payload[0], CAN_DIAG_SAT16(stats->latency_last_us));
+    CAN_APP_Put_U16(&payload[2], CAN_DIAG_SAT16(stats->latency_max_us));
+    CAN_APP_Put_U16(&payload[4], CAN_DIAG_SAT16(stats->request_latency_max_us));
+    payload[6] = CAN_DIAG_SAT8(stats->sent);
+    payload[7] = CAN_DIAG_SAT8(stats->fallbacks);
+}
+
+/**
+ * @brief Payload del frame de diagnóstico del handshake de inicio (CONTROL_DIAG_STARTUP, ver can_def.h).
+ *
+ * @param payload Payload de 8 bytes
+ * @retval None
+ */
+static void CAN_APP_Build_DiagStartup(uint8_t *payload)
+{
+    const app_startup_stats_t *stats = MX_APP_Get_StartupStats();
+
+    CAN_APP_Put_U16(&payload[0], CAN_DIAG_SAT16(stats->time_to_ready_ms));
+    payload[2] = CAN_DIAG_SAT8(stats->echoes);
+
+    for (uint32_t i = 0; i < kSTARTUP_MODULE_COUNT; i++)
+    {
+        payload[4U + i] = CAN_DIAG_SAT8(stats->ack_ms[i] / 100U);
+    }
+}
+
+/**
+ * @brief Payload del frame de diagnóstico de carga de CPU (CONTROL_DIAG_CPU, ver can_def.h).
+ *
+ * @param payload Payload de 8 bytes
+ * @retval None
+ */
+static void CAN_APP_Build_DiagCpu(uint8_t *payload)
+{
+    const scheduler_cpu_stats_t *stats = SCHEDULER_Get_CpuStats();
+
+    CAN_APP_Put_U16(&payload[0], CAN_DIAG_SAT16(stats->load_permille));
+    CAN_APP_Put_U16(&payload[2], CAN_DIAG_SAT16(stats->load_max_permille));
+    CAN_APP_Put_U16(&payload[4], CAN_DIAG_SAT16(stats->wakeups));
+}
+
+#if PROFILING_ENABLED == 1
+/**
+ * @brief Payload del frame de diagnóstico de tiempo de ejecución (CONTROL_DIAG_PROFILING, ver can_def.h).
+ *
+ * Cada llamada toma el siguiente punto de medición.
+ *
+ * @param payload Payload de 8 bytes
+ * @retval None
+ */
+static void CAN_APP_Build_DiagProfiling(uint8_t *payload)
+{
+    /** Punto de medición del siguiente frame */
+    static uint8_t probe = 0;
+
+    /** Ejecuciones de cada punto de medición en su frame anterior */
+    static uint32_t last_count[kPROFILE_COUNT];
+
+    const profiling_stats_t *stats = PROFILING_Get_Stats((profiling_probe_t)probe);
+    uint32_t cycles_per_us = SystemCoreClock / 1000000U;
+    uint32_t count = stats->count;
+    uint32_t min_cycles = (count > 0U) ? stats->min_cycles : 0U;
+    uint32_t mean_cycles = (count > 0U) ? (uint32_t)(stats->sum_cycles / count) : 0U;
+
+    payload[0] = probe;
+    CAN_APP_Put_U16(&payload[1], CAN_DIAG_SAT16(((uint64_t)min_cycles * 10U) / cycles_per_us));
+    CAN_APP_Put_U16(&payload[3], CAN_DIAG_SAT16(((uint64_t)stats->max_cycles * 10U) / cycles_per_us));
+    CAN_APP_Put_U16(&payload[5], CAN_DIAG_SAT16(((uint64_t)mean_cycles * 10U) / cycles_per_us));
+    payload[7] = CAN_DIAG_SAT8((count - last_count[probe] + 7U) / 8U);
+
+    last_count[probe] = count;
+
+    probe = (probe + 1U < kPROFILE_COUNT) ? probe + 1U : 0U;
+}
+#endif /* PROFILING_ENABLED */
+
+/**
+ * @brief Payload del frame de diagnóstico de uso de RAM (CONTROL_DIAG_RAM, ver can_def.h).
+ *
+ * @param payload Payload de 8 bytes
+ * @retval None
+ */
+static void CAN_APP_Build_DiagRam(uint8_t *payload)
+{
+    const ram_monitor_stats_t *stats = RAM_MONITOR_Get_Stats();
+
+    CAN_APP_Put_U16(&payload[0], CAN_DIAG_SAT16(stats->stack_used_max));
+    CAN_APP_Put_U16(&payload[2], CAN_DIAG_SAT16(stats->stack_size));
+    CAN_APP_Put_U16(&payload[4], CAN_DIAG_SAT16(stats->heap_used_max));
+    CAN_APP_Put_U16(&payload[6], CAN_DIAG_SAT16(stats->heap_size));
+}
+
+/**
+ * @brief Payload del frame de diagnóstico del limitador de pendiente (CONTROL_DIAG_RAMPA, ver can_def.h).
+ *
+ * @param payload Payload de 8 bytes
+ * @retval None
+ */
+static void CAN_APP_Build_DiagRampa(uint8_t *payload)
+{
+    const rampa_pedal_slew_t *slew = RAMPA_PEDAL_Get_Slew();
+
+    payload[0] = (uint8_t)(slew->target >> CAN_PEDAL_FRAC_BITS);
+    payload[1] = (uint8_t)(slew->level >> CAN_PEDAL_FRAC_BITS);
+    CAN_APP_Put_U16(&payload[2], CAN_DIAG_SAT16(slew->output >> (RAMPA_PEDAL_SLEW_FRAC_BITS - 8U)));
+    payload[4] = (uint8_t)((slew->rising ? 0x01U : 0U) | (slew->falling ? 0x02U : 0U));
+    CAN_APP_Put_U16(&payload[6], CAN_DIAG_SAT16(slew->limited_periods));
+}
+
+/**
+ * @brief Escribe un valor de 16 bits little-endian en un payload.
+ *
+ * @param payload Posición del payload
+ * @param value Valor a escribir
+ * @retval None
+ */
+static void CAN_APP_Put_U16(uint8_t *payload, uint16_t value)
+{
+    payload[0] = (uint8_t)value;
+    payload[1] = (uint8_t)(value >> 8);
+}
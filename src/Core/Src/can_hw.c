@@ -15,10 +15,29 @@
 
 #include "can_hw.h"
 
+#include "indicators.h"
+
 /***********************************************************************************************************************
  * Private macros
  **********************************************************************************************************************/
 
+/** @brief Número de excepción (IPSR) de una interrupción de periférico */
+#define CAN_HW_EXCEPTION_NUMBER(irqn)	((uint32_t)(irqn) + 16U)
+
+/** @brief Errores de protocolo CAN (campo LEC de ESR), en el orden de sus códigos */
+#define CAN_HW_PROTOCOL_ERRORS	(HAL_CAN_ERROR_STF | HAL_CAN_ERROR_FOR | HAL_CAN_ERROR_ACK | \
+								 HAL_CAN_ERROR_BR | HAL_CAN_ERROR_BD | HAL_CAN_ERROR_CRC)
+
+/** @brief Número de mailboxes de transmisión de hardware */
+#define CAN_HW_NUM_OF_TX_MAILBOXES	3U
+
+
+/** @brief Bits de TSR de un mailbox de transmisión (RQCP, TXOK, ALST, TERR, ABRQ) */
+#define CAN_HW_TSR_MAILBOX_SHIFT(mailbox)	((mailbox) * 8U)
+
+/** @brief Bits de estado de error de ESR */
+#define CAN_HW_ERROR_FLAGS		(CAN_ESR_EWGF | CAN_ESR_EPVF | CAN_ESR_BOFF)
+
 /** @brief Transmit message for CAN testing */
 #define SEND_TEST_MESSAGE		0
 
@@ -29,11 +48,50 @@
 /** @brief CAN object instance */
 CAN_t can_obj;
 
-/** @brief Bandera mensaje recibido CAN */
-can_rx_status_t flag_rx_can = CAN_MSG_NOT_RECEIVED;
+/** @brief Buffers circulares de mensajes recibidos CAN, uno por FIFO de recepción */
+static can_rx_buffer_t rx_buffers[2];
+
+/** @brief Estadísticas de errores CAN */
+static can_error_stats_t error_stats;
+
+/** @brief Cola de transmisión CAN */
+static can_tx_queue_t tx_queue;
+
+/** @brief Estadísticas de la cola de transmisión CAN */
+static can_tx_queue_stats_t tx_queue_stats;
+
+/** @brief Estadísticas de frames express */
+static can_express_stats_t express_stats;
+
+/** @brief ID del frame express en espera de transmisión completa */
+static uint32_t express_id;
+
+/** @brief Token de carga del frame express en espera, 0 mientras no está en un mailbox */
+static uint32_t express_token;
+
+/** @brief Token de la última carga de cada mailbox de transmisión */
+static uint32_t tx_mailbox_token[CAN_HW_NUM_OF_TX_MAILBOXES];
 
-/** @brief Bandera transmisión CAN */
-can_tx_status_t flag_tx_can = CAN_TX_READY;
+/** @brief Contador de cargas de mailbox, fuente de los tokens (nunca 0) */
+static uint32_t tx_load_seq;
+
+/** @brief Tiempo [us] de detección del evento del frame express en espera */
+static uint32_t express_detect_us;
+
+/** @brief Tiempo [us] de solicitud del frame express en espera */
+static uint32_t express_request_us;
+
+/** @brief Hay un frame express en espera de transmisión completa */
+static volatile bool express_pending = false;
+
+/** @brief Tick de inicio de espera de reinicio por bus-off */
+static uint32_t busoff_tickstart;
+
+/** @brief Hay una espera de reinicio por bus-off en curso */
+static bool busoff_pending = false;
+
+/** @brief Contador de slots de transmisión CAN (incrementa cada CAN_TX_SLOT_MS) */
+volatile uint32_t can_tx_slot_count = 0;
 
 #if SEND_TEST_MESSAGE == 1
 /** @brief ID para prueba comunicación CAN */
@@ -45,10 +103,38 @@ static uint8_t test_msg_id = 0x31;
  * Private functions prototypes
  **********************************************************************************************************************/
 
+static void CAN_HW_Receive_Fifo(can_rx_fifo_t fifo);
+
+static void CAN_HW_Read_RxMailbox(can_rx_fifo_t fifo, can_frame_t *frame);
+
+static bool CAN_HW_Pop_Frame(can_rx_buffer_t *rx_buffer, can_frame_t *frame);
+
+static void CAN_HW_Recover_BusOff(void);
+
+static void CAN_HW_Feed_TxMailboxes(void);
+
+static uint32_t CAN_HW_Get_TxFreeLevel(void);
+
+static uint32_t CAN_HW_Load_TxMailbox(uint32_t id, uint8_t dlc, const uint8_t *data);
+
+static uint32_t CAN_HW_Get_TxPending(uint32_t id);
+
+static void CAN_HW_Remove_Queued(uint32_t id);
+
+static void CAN_HW_Tx_Complete(uint32_t mailbox);
+
 /***********************************************************************************************************************
  * Public functions implementation
  **********************************************************************************************************************/
 
+/**
+ * @brief Inicialización de hardware CAN de tarjeta Control.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param None
+ * @retval None
+ */
 void CAN_HW_Init(void)
 {
 	/* Inicializa CAN usando driver */
@@ -56,9 +142,360 @@ void CAN_HW_Init(void)
 				 STANDARD_FRAME,
 				 NORMAL_MSG,
 				 CAN_Wrapper_Init,
-				 CAN_Wrapper_TransmitData,
-				 CAN_Wrapper_ReceiveData,
-				 CAN_Wrapper_DataCount);
+				 CAN_HW_Queue_Frame);
+}
+
+/**
+ * @brief Obtiene el mensaje más antiguo de los buffers de recepción CAN.
+ *
+ * Los mensajes de FIFO1 (latencia crítica) se entregan antes que los de FIFO0.
+ * Solo debe ser llamada desde el loop principal (único consumidor de los buffers).
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param frame Puntero a frame donde se copia el mensaje recibido
+ * @retval true     Se obtuvo un mensaje
+ * @retval false    Buffers vacíos
+ */
+bool CAN_HW_Get_ReceivedFrame(can_frame_t *frame)
+{
+	if (CAN_HW_Pop_Frame(&rx_buffers[RX_FIFO_1], frame))
+	{
+		return true;
+	}
+
+	return CAN_HW_Pop_Frame(&rx_buffers[RX_FIFO_0], frame);
+}
+
+/**
+ * @brief Número de mensajes CAN descartados por buffer de recepción lleno.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param fifo FIFO de recepción
+ * @return uint32_t Mensajes descartados
+ */
+uint32_t CAN_HW_Get_RxOverflowCount(can_rx_fifo_t fifo)
+{
+	return rx_buffers[fifo].overflow_count;
+}
+
+/**
+ * @brief Máximo número de mensajes CAN que han estado en el buffer de recepción.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param fifo FIFO de recepción
+ * @return uint32_t High-water mark del buffer
+ */
+uint32_t CAN_HW_Get_RxHighWater(can_rx_fifo_t fifo)
+{
+	return rx_buffers[fifo].high_water;
+}
+
+/**
+ * @brief Supervisión de errores CAN, llamada en cada pasada del loop principal.
+ *
+ * Actualiza TEC, REC y estado de error desde el registro ESR. Con AutoBusOff deshabilitado el
+ * periférico permanece en bus-off hasta que el software lo reinicia: tras CAN_BUSOFF_RECOVERY_TIME_MS
+ * en bus-off se reinicia el periférico, y el hardware vuelve al bus después de 128 secuencias de
+ * 11 bits recesivos. Si sigue en bus-off, se reintenta con el mismo periodo.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param None
+ * @retval None
+ */
+void CAN_HW_Process(void)
+{
+	uint32_t esr = hcan1.Instance->ESR;
+
+	error_stats.tec = (uint8_t)((esr & CAN_ESR_TEC) >> CAN_ESR_TEC_Pos);
+	error_stats.rec = (uint8_t)((esr & CAN_ESR_REC) >> CAN_ESR_REC_Pos);
+
+	/* Los estados de error que terminaron se limpian para contar la siguiente entrada (ver HAL_CAN_ErrorCallback) */
+	__disable_irq();
+	error_stats.error_flags &= esr;
+	__enable_irq();
+
+	if ((esr & CAN_ESR_BOFF) == 0U)
+	{
+		busoff_pending = false;
+	}
+	else if (!busoff_pending)
+	{
+		busoff_pending = true;
+		busoff_tickstart = HAL_GetTick();
+	}
+	else if ((HAL_GetTick() - busoff_tickstart) >= CAN_BUSOFF_RECOVERY_TIME_MS)
+	{
+		CAN_HW_Recover_BusOff();
+
+		busoff_pending = false;
+	}
+
+	/* Mailboxes liberados sin interrupción de transmisión completa (abortos, reinicio por bus-off) */
+	CAN_HW_Feed_TxMailboxes();
+}
+
+/**
+ * @brief Estadísticas de errores CAN.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param None
+ * @return const can_error_stats_t* Estadísticas de errores CAN
+ */
+const can_error_stats_t *CAN_HW_Get_ErrorStats(void)
+{
+	return &error_stats;
+}
+
+/**
+ * @brief Agrega un mensaje a la cola de transmisión CAN.
+ *
+ * Función de envío del driver CAN (send_can_data_t): nunca bloquea. El mensaje se inserta
+ * según su prioridad de arbitraje y se carga en un mailbox libre de inmediato, o desde la
+ * interrupción de mailbox libre. Con la cola llena, el mensaje de menor prioridad (el nuevo
+ * o el último de la cola) se descarta.
+ *
+ * Puede ser llamada desde el loop principal o desde interrupciones.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param id Standard identifier
+ * @param ide Type of identifier
+ * @param rtr Type of frame
+ * @param dlc Length of frame
+ * @param data Data to transmit
+ * @return can_status_t CAN_STATUS_ERROR si el mensaje se descartó por cola llena
+ */
+RAMFUNC can_status_t CAN_HW_Queue_Frame(uint32_t id, uint8_t ide, uint8_t rtr, uint8_t dlc, uint8_t *data)
+{
+	uint32_t primask = __get_PRIMASK();
+	uint32_t queued_us = TIMEBASE_Get_TimeUs();
+	uint32_t i;
+
+	__disable_irq();
+
+	if (tx_queue.count >= CAN_TX_QUEUE_SIZE)
+	{
+		tx_queue_stats.drops++;
+
+		if (id >= tx_queue.entries[CAN_TX_QUEUE_SIZE - 1U].id)
+		{
+			__set_PRIMASK(primask);
+
+			return CAN_STATUS_ERROR;
+		}
+
+		/* Se descarta el último mensaje de la cola, de menor prioridad que el nuevo */
+		tx_queue.count--;
+	}
+
+	/* Inserción ordenada por ID, después de los mensajes del mismo ID */
+	i = tx_queue.count;
+
+	while (i > 0U && tx_queue.entries[i - 1U].id > id)
+	{
+		tx_queue.entries[i] = tx_queue.entries[i - 1U];
+		i--;
+	}
+
+	tx_queue.entries[i].id = id;
+	tx_queue.entries[i].dlc = dlc;
+
+	/* Copia sin memcpy, que está en flash */
+	for (uint32_t j = 0; j < dlc; j++)
+	{
+		tx_queue.entries[i].data[j] = data[j];
+	}
+
+	tx_queue.entries[i].queued_us = queued_us;
+	tx_queue.count++;
+
+	tx_queue_stats.queued++;
+
+	if (tx_queue.count > tx_queue_stats.high_water)
+	{
+		tx_queue_stats.high_water = tx_queue.count;
+	}
+
+	CAN_HW_Feed_TxMailboxes();
+
+	__set_PRIMASK(primask);
+
+	return CAN_STATUS_OK;
+}
+
+/**
+ * @brief Transmite un frame express (autokill) en el mailbox reservado.
+ *
+ * El frame se carga de inmediato en el mailbox que la cola de transmisión deja libre
+ * (CAN_TX_RESERVED_MAILBOXES), sin pasar por la cola, y por prioridad de ID el hardware lo
+ * transmite antes que los demás mailboxes pendientes. Los mensajes anteriores con el mismo ID
+ * se descartan de la cola y se abortan en los mailboxes, para que no lleguen después del
+ * frame express. Si no hay mailbox libre (periférico detenido por bus-off) el frame entra a
+ * la cola, donde su ID lo pone primero.
+ *
+ * Puede ser llamada desde el loop principal o desde interrupciones.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param id Standard identifier
+ * @param dlc Length of frame
+ * @param data Data to transmit
+ * @param detect_us Tiempo [us] de recepción del frame que originó el evento (TIMEBASE_Get_TimeUs)
+ * @return can_status_t CAN_STATUS_ERROR si el frame no se pudo cargar ni encolar
+ */
+RAMFUNC can_status_t CAN_HW_Send_Express(uint32_t id, uint8_t dlc, const uint8_t *data, uint32_t detect_us)
+{
+	uint32_t primask = __get_PRIMASK();
+	uint8_t payload[PAYLOAD_MAX_LENGTH];
+	uint32_t pending;
+	can_status_t status = CAN_STATUS_OK;
+
+	__disable_irq();
+
+	express_detect_us = detect_us;
+	express_request_us = TIMEBASE_Get_TimeUs();
+	express_id = id;
+	express_token = 0;
+	express_pending = true;
+	express_stats.requests++;
+
+	for (uint32_t i = 0; i < dlc; i++)
+	{
+		payload[i] = data[i];
+	}
+
+	/* Mensajes del mismo ID encolados o pendientes en mailbox quedan obsoletos */
+	CAN_HW_Remove_Queued(id);
+
+	pending = CAN_HW_Get_TxPending(id);
+
+	for (uint32_t mailbox = 0; mailbox < CAN_HW_NUM_OF_TX_MAILBOXES; mailbox++)
+	{
+		if ((pending & (CAN_TX_MAILBOX0 << mailbox)) != 0U)
+		{
+			/* Escritura directa: RQCP se borra escribiendo 1, no se puede modificar TSR con lectura-escritura */
+			hcan1.Instance->TSR = CAN_TSR_ABRQ0 << CAN_HW_TSR_MAILBOX_SHIFT(mailbox);
+		}
+	}
+
+	express_token = CAN_HW_Load_TxMailbox(id, dlc, payload);
+
+	if (express_token == 0U)
+	{
+		express_stats.fallbacks++;
+
+		status = CAN_HW_Queue_Frame(id, STANDARD_FRAME, NORMAL_MSG, dlc, payload);
+	}
+
+	__set_PRIMASK(primask);
+
+	return status;
+}
+
+/**
+ * @brief Estadísticas de frames express.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param None
+ * @return const can_express_stats_t* Estadísticas de frames express
+ */
+const can_express_stats_t *CAN_HW_Get_ExpressStats(void)
+{
+	return &express_stats;
+}
+
+/**
+ * @brief Estadísticas de la cola de transmisión CAN.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param None
+ * @return const can_tx_queue_stats_t* Estadísticas de la cola de transmisión CAN
+ */
+const can_tx_queue_stats_t *CAN_HW_Get_TxQueueStats(void)
+{
+	return &tx_queue_stats;
+}
+
+/**
+ * @brief Atiende la interrupción de un FIFO de recepción sin pasar por HAL.
+ *
+ * Vacía el FIFO en su buffer circular leyendo los registros del periférico y borra la bandera
+ * de FIFO lleno, que no se borra sola al leer los mensajes. Se llama desde
+ * CAN1_RX0_IRQHandler/CAN1_RX1_IRQHandler antes de HAL_CAN_IRQHandler, que está en flash y
+ * solo hace falta para registrar el overrun.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param fifo FIFO de recepción
+ * @retval true     Queda la bandera de overrun para HAL_CAN_IRQHandler
+ * @retval false    Interrupción atendida
+ */
+RAMFUNC bool CAN_HW_Service_RxFifo(can_rx_fifo_t fifo)
+{
+	__IO uint32_t *rfr = (fifo == RX_FIFO_1) ? &hcan1.Instance->RF1R : &hcan1.Instance->RF0R;
+	uint32_t flags;
+
+	CAN_HW_Receive_Fifo(fifo);
+
+	flags = *rfr;
+
+	/* Escritura directa: FULL y FOVR se borran escribiendo 1 (misma posición en RF0R y RF1R) */
+	if ((flags & CAN_RF0R_FULL0) != 0U)
+	{
+		*rfr = CAN_RF0R_FULL0;
+	}
+
+	return (flags & CAN_RF0R_FOVR0) != 0U;
+}
+
+/**
+ * @brief Atiende la interrupción de transmisión sin pasar por HAL.
+ *
+ * Por cada mailbox que transmitió con éxito borra su bandera de petición completa y carga el
+ * siguiente mensaje de la cola. Las transmisiones fallidas o abortadas quedan para
+ * HAL_CAN_IRQHandler, que registra el error.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param None
+ * @retval true     Quedan peticiones completas con error para HAL_CAN_IRQHandler
+ * @retval false    Interrupción atendida
+ */
+RAMFUNC bool CAN_HW_Service_TxMailboxes(void)
+{
+	uint32_t tsr = hcan1.Instance->TSR;
+	bool unhandled = false;
+
+	for (uint32_t mailbox = 0; mailbox < CAN_HW_NUM_OF_TX_MAILBOXES; mailbox++)
+	{
+		uint32_t shift = CAN_HW_TSR_MAILBOX_SHIFT(mailbox);
+
+		if ((tsr & (CAN_TSR_RQCP0 << shift)) == 0U)
+		{
+			continue;
+		}
+
+		if ((tsr & (CAN_TSR_TXOK0 << shift)) == 0U)
+		{
+			unhandled = true;
+
+			continue;
+		}
+
+		/* Borra RQCP, TXOK, ALST y TERR del mailbox */
+		hcan1.Instance->TSR = CAN_TSR_RQCP0 << shift;
+
+		CAN_HW_Tx_Complete(mailbox);
+	}
+
+	return unhandled;
 }
 
 /***********************************************************************************************************************
@@ -66,18 +503,113 @@ void CAN_HW_Init(void)
  **********************************************************************************************************************/
 
 /*
- * Callback mensaje CAN recibido
+ * Callback mensaje CAN recibido en FIFO0 (telemetría)
+ */
+RAMFUNC void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef* hcan)
+{
+	/*
+	 * HAL_CAN_IRQHandler atiende todas las fuentes de CAN1 desde cualquier vector. Cada FIFO
+	 * solo se vacía desde su propio vector para que su buffer tenga un único productor.
+	 */
+	if (__get_IPSR() != CAN_HW_EXCEPTION_NUMBER(CAN1_RX0_IRQn))
+	{
+		return;
+	}
+
+	CAN_HW_Receive_Fifo(RX_FIFO_0);
+}
+
+/*
+ * Callback mensaje CAN recibido en FIFO1 (mensajes de latencia crítica)
+ */
+RAMFUNC void HAL_CAN_RxFifo1MsgPendingCallback(CAN_HandleTypeDef* hcan)
+{
+	/* Solo se vacía desde su propio vector (ver HAL_CAN_RxFifo0MsgPendingCallback) */
+	if (__get_IPSR() != CAN_HW_EXCEPTION_NUMBER(CAN1_RX1_IRQn))
+	{
+		return;
+	}
+
+	CAN_HW_Receive_Fifo(RX_FIFO_1);
+}
+
+/*
+ * Callback errores CAN (estado de error, errores de protocolo y overrun de FIFO)
  */
-void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef* hcan)
+void HAL_CAN_ErrorCallback(CAN_HandleTypeDef *hcan)
 {
-    /* The flag indicates that the callback was called */
-    flag_rx_can = CAN_MSG_RECEIVED;
+	uint32_t primask = __get_PRIMASK();
+	uint32_t error_code;
+	uint32_t error_flags;
+	uint32_t new_error_flags;
+
+	/*
+	 * Se llama desde los vectores RX0, RX1 y SCE, con distinta prioridad. HAL acumula los
+	 * errores en hcan->ErrorCode; se leen y limpian junto con los contadores sin interrupciones.
+	 */
+	__disable_irq();
+
+	error_code = hcan->ErrorCode;
+	hcan->ErrorCode = HAL_CAN_ERROR_NONE;
+
+	if (error_code & HAL_CAN_ERROR_RX_FOV0)
+	{
+		error_stats.rx_fifo_overrun[RX_FIFO_0]++;
+	}
 
-	/* Get the received message */
-	if(CAN_API_Read_Message(&can_obj) != CAN_STATUS_OK)
+	if (error_code & HAL_CAN_ERROR_RX_FOV1)
 	{
-		Error_Handler();
+		error_stats.rx_fifo_overrun[RX_FIFO_1]++;
 	}
+
+	if (error_code & CAN_HW_PROTOCOL_ERRORS)
+	{
+		error_stats.bus_errors++;
+
+		/* HAL_CAN_ERROR_STF corresponde a LEC = 1 */
+		error_stats.last_error_code = (uint8_t)(__builtin_ctz(error_code & CAN_HW_PROTOCOL_ERRORS) - 2);
+	}
+
+	/* HAL reporta los estados de error en cada interrupción mientras siguen activos: solo se cuentan las entradas */
+	error_flags = hcan->Instance->ESR & CAN_HW_ERROR_FLAGS;
+	new_error_flags = error_flags & ~error_stats.error_flags;
+
+	if (new_error_flags & CAN_ESR_EWGF)
+	{
+		error_stats.error_warning++;
+	}
+
+	if (new_error_flags & CAN_ESR_EPVF)
+	{
+		error_stats.error_passive++;
+	}
+
+	if (new_error_flags & CAN_ESR_BOFF)
+	{
+		error_stats.bus_off++;
+	}
+
+	error_stats.error_flags = error_flags;
+
+	__set_PRIMASK(primask);
+}
+
+/*
+ * Callbacks transmisión completa de mailbox: carga el siguiente mensaje de la cola
+ */
+RAMFUNC void HAL_CAN_TxMailbox0CompleteCallback(CAN_HandleTypeDef *hcan)
+{
+	CAN_HW_Tx_Complete(0);
+}
+
+RAMFUNC void HAL_CAN_TxMailbox1CompleteCallback(CAN_HandleTypeDef *hcan)
+{
+	CAN_HW_Tx_Complete(1);
+}
+
+RAMFUNC void HAL_CAN_TxMailbox2CompleteCallback(CAN_HandleTypeDef *hcan)
+{
+	CAN_HW_Tx_Complete(2);
 }
 
 /*
@@ -100,16 +632,16 @@ void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef* htim)
 		can_obj.Frame.payload_length = 1;
 		can_obj.Frame.payload_buff[0] = 0x25;
 
-		if(CAN_API_Send_Message(&can_obj) != CAN_STATUS_OK)
-		{
-			Error_Handler();
-		}
+		(void)CAN_API_Send_Message(&can_obj);
 	}
 #else
 	if(htim == &htim7)
 	{
-		/* The flag indicates that the callback was called */
-		flag_tx_can = CAN_TX_READY;
+		/* Nuevo slot de transmisión CAN */
+		can_tx_slot_count++;
+
+		/* Patrones de LEDs y buzzer */
+		INDICATORS_Tick();
 	}
 
 #endif /* SEND_TEST_MESSAGE */
@@ -118,3 +650,370 @@ void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef* htim)
 /***********************************************************************************************************************
  * Private functions implementation
  **********************************************************************************************************************/
+
+/**
+ * @brief Vacía un FIFO de recepción de hardware en su buffer circular.
+ *
+ * Lee mensajes hasta que el nivel de llenado del FIFO es cero, de modo que una ráfaga
+ * se atiende en una sola entrada a la interrupción. Cada FIFO tiene su propio buffer,
+ * por lo que cada buffer tiene un único productor aunque las interrupciones de FIFO0 y
+ * FIFO1 tengan distinta prioridad.
+ *
+ * @param fifo FIFO de recepción
+ */
+static RAMFUNC void CAN_HW_Receive_Fifo(can_rx_fifo_t fifo)
+{
+	/* Frame temporal para vaciar el FIFO de hardware cuando el buffer está lleno */
+	static can_frame_t discard_frame;
+
+	can_rx_buffer_t *rx_buffer = &rx_buffers[fifo];
+	__IO uint32_t *rfr = (fifo == RX_FIFO_1) ? &hcan1.Instance->RF1R : &hcan1.Instance->RF0R;
+
+	/* FMP1 tiene la misma posición que FMP0 */
+	while ((*rfr & CAN_RF0R_FMP0) != 0U)
+	{
+		uint32_t head = rx_buffer->head;
+		uint32_t count = head - rx_buffer->tail;
+
+		if (count >= CAN_RX_BUFFER_SIZE)
+		{
+			/* Buffer lleno: se lee el mensaje para liberar el FIFO, pero se descarta */
+			CAN_HW_Read_RxMailbox(fifo, &discard_frame);
+
+			rx_buffer->overflow_count++;
+
+			continue;
+		}
+
+		/* Get the received message */
+		CAN_HW_Read_RxMailbox(fifo, &rx_buffer->frames[head & CAN_RX_BUFFER_MASK]);
+
+		/* El mensaje se escribe antes de publicarlo al loop principal */
+		__DMB();
+
+		rx_buffer->head = head + 1U;
+
+		if (count + 1U > rx_buffer->high_water)
+		{
+			rx_buffer->high_water = count + 1U;
+		}
+	}
+}
+
+/**
+ * @brief Lee el mensaje de salida de un FIFO de recepción y lo libera.
+ *
+ * Equivale a HAL_CAN_GetRxMessage para identificadores estándar, sin salir de SRAM.
+ * El FIFO se libera escribiendo solo RFOM, para no borrar las banderas de FIFO lleno y
+ * overrun antes de que HAL las registre.
+ *
+ * @param fifo FIFO de recepción con al menos un mensaje
+ * @param frame Frame donde se copia el mensaje
+ * @retval None
+ */
+static RAMFUNC void CAN_HW_Read_RxMailbox(can_rx_fifo_t fifo, can_frame_t *frame)
+{
+	CAN_FIFOMailBox_TypeDef *mailbox = &hcan1.Instance->sFIFOMailBox[fifo];
+	uint32_t rdlr = mailbox->RDLR;
+	uint32_t rdhr = mailbox->RDHR;
+
+	frame->id = (mailbox->RIR & CAN_RI0R_STID) >> CAN_RI0R_STID_Pos;
+	frame->DLC = (uint8_t)((mailbox->RDTR & CAN_RDT0R_DLC) >> CAN_RDT0R_DLC_Pos);
+	frame->payload_length = frame->DLC;
+	frame->timestamp_us = TIMEBASE_Get_TimeUs();
+
+	for (uint32_t i = 0; i < 4U; i++)
+	{
+		frame->payload_buff[i] = (uint8_t)(rdlr >> (8U * i));
+		frame->payload_buff[i + 4U] = (uint8_t)(rdhr >> (8U * i));
+	}
+
+	if (fifo == RX_FIFO_1)
+	{
+		hcan1.Instance->RF1R = CAN_RF1R_RFOM1;
+	}
+	else
+	{
+		hcan1.Instance->RF0R = CAN_RF0R_RFOM0;
+	}
+}
+
+/**
+ * @brief Obtiene el mensaje más antiguo de un buffer de recepción.
+ *
+ * @param rx_buffer Buffer de recepción
+ * @param frame Puntero a frame donde se copia el mensaje recibido
+ * @retval true     Se obtuvo un mensaje
+ * @retval false    Buffer vacío
+ */
+static bool CAN_HW_Pop_Frame(can_rx_buffer_t *rx_buffer, can_frame_t *frame)
+{
+	uint32_t tail = rx_buffer->tail;
+
+	if (rx_buffer->head == tail)
+	{
+		return false;
+	}
+
+	*frame = rx_buffer->frames[tail & CAN_RX_BUFFER_MASK];
+
+	/* El mensaje se copia antes de liberar la posición al ISR */
+	__DMB();
+
+	rx_buffer->tail = tail + 1U;
+
+	return true;
+}
+
+/**
+ * @brief Reinicio del periférico CAN para salir de bus-off.
+ *
+ * Entra y sale del modo inicialización; la configuración, los filtros y las interrupciones
+ * se conservan. Si el reinicio falla, se reintenta en la siguiente espera de bus-off.
+ *
+ * @param None
+ * @retval None
+ */
+static void CAN_HW_Recover_BusOff(void)
+{
+	/* Falla si un intento anterior dejó el periférico detenido */
+	(void)HAL_CAN_Stop(&hcan1);
+
+	if (HAL_CAN_Start(&hcan1) == HAL_OK)
+	{
+		error_stats.bus_off_recoveries++;
+	}
+}
+
+/**
+ * @brief Carga mensajes de la cola de transmisión en los mailboxes libres.
+ *
+ * Siempre quedan CAN_TX_RESERVED_MAILBOXES mailboxes libres para frames express.
+ *
+ * Se carga el mensaje de mayor prioridad de la cola cuyo ID no esté ya pendiente en un
+ * mailbox. Los mailboxes usan prioridad por ID (TransmitFifoPriority deshabilitado), de modo
+ * que el hardware también transmite primero el ID menor; como dos mensajes del mismo ID nunca
+ * están en mailboxes a la vez, se conserva su orden sin usar el modo FIFO de mailboxes.
+ *
+ * Se llama desde el loop principal y desde interrupciones de cualquier prioridad (HAL atiende
+ * las fuentes de CAN1 desde todos sus vectores), por lo que se ejecuta sin interrupciones.
+ *
+ * @param None
+ * @retval None
+ */
+static RAMFUNC void CAN_HW_Feed_TxMailboxes(void)
+{
+	uint32_t primask = __get_PRIMASK();
+
+	__disable_irq();
+
+	while (tx_queue.count > 0U && CAN_HW_Get_TxFreeLevel() > CAN_TX_RESERVED_MAILBOXES)
+	{
+		uint32_t i = 0;
+		uint32_t token;
+		uint32_t latency_us;
+
+		while (i < tx_queue.count && CAN_HW_Get_TxPending(tx_queue.entries[i].id) != 0U)
+		{
+			i++;
+		}
+
+		if (i == tx_queue.count)
+		{
+			break;
+		}
+
+		token = CAN_HW_Load_TxMailbox(tx_queue.entries[i].id, tx_queue.entries[i].dlc, tx_queue.entries[i].data);
+
+		/* Frame express que no encontró mailbox libre: el primero de su ID en salir de la cola */
+		if (express_pending && express_token == 0U && tx_queue.entries[i].id == express_id)
+		{
+			express_token = token;
+		}
+
+		latency_us = TIMEBASE_Get_TimeUs() - tx_queue.entries[i].queued_us;
+
+		tx_queue_stats.sent++;
+		tx_queue_stats.latency_last_us = latency_us;
+		tx_queue_stats.latency_sum_us += latency_us;
+
+		if (latency_us > tx_queue_stats.latency_max_us)
+		{
+			tx_queue_stats.latency_max_us = latency_us;
+		}
+
+		tx_queue.count--;
+
+		for (; i < tx_queue.count; i++)
+		{
+			tx_queue.entries[i] = tx_queue.entries[i + 1U];
+		}
+	}
+
+	tx_queue_stats.depth = tx_queue.count;
+
+	__set_PRIMASK(primask);
+}
+
+/**
+ * @brief Número de mailboxes de transmisión libres.
+ *
+ * @param None
+ * @return uint32_t Mailboxes libres (0 a 3)
+ */
+static RAMFUNC uint32_t CAN_HW_Get_TxFreeLevel(void)
+{
+	uint32_t tsr = hcan1.Instance->TSR;
+	uint32_t free_level = 0;
+
+	for (uint32_t mailbox = 0; mailbox < CAN_HW_NUM_OF_TX_MAILBOXES; mailbox++)
+	{
+		if ((tsr & (CAN_TSR_TME0 << mailbox)) != 0U)
+		{
+			free_level++;
+		}
+	}
+
+	return free_level;
+}
+
+/**
+ * @brief Carga un mensaje con identificador estándar en un mailbox libre y pide su transmisión.
+ *
+ * Equivale a HAL_CAN_AddTxMessage, sin salir de SRAM. Si el periférico está detenido
+ * (reinicio por bus-off), el mensaje se transmite al volver a arrancar.
+ *
+ * Cada carga recibe un token distinto, guardado para el mailbox, que identifica esa carga en
+ * CAN_HW_Tx_Complete aunque otro mensaje anterior del mismo ID haya usado el mailbox.
+ *
+ * Debe llamarse con interrupciones deshabilitadas.
+ *
+ * @param id Standard identifier
+ * @param dlc Length of frame
+ * @param data Data to transmit (8 bytes)
+ * @return uint32_t Token de la carga, 0 si no hay mailbox libre
+ */
+static RAMFUNC uint32_t CAN_HW_Load_TxMailbox(uint32_t id, uint8_t dlc, const uint8_t *data)
+{
+	uint32_t tsr = hcan1.Instance->TSR;
+	uint32_t index;
+	CAN_TxMailBox_TypeDef *mailbox;
+
+	if ((tsr & (CAN_TSR_TME0 | CAN_TSR_TME1 | CAN_TSR_TME2)) == 0U)
+	{
+		return 0U;
+	}
+
+	/* CODE indica el siguiente mailbox libre */
+	index = (tsr & CAN_TSR_CODE) >> CAN_TSR_CODE_Pos;
+	mailbox = &hcan1.Instance->sTxMailBox[index];
+
+	tx_load_seq++;
+
+	if (tx_load_seq == 0U)
+	{
+		tx_load_seq = 1U;
+	}
+
+	tx_mailbox_token[index] = tx_load_seq;
+
+	mailbox->TDTR = dlc;
+	mailbox->TDLR = ((uint32_t)data[3] << 24) | ((uint32_t)data[2] << 16) | ((uint32_t)data[1] << 8) | data[0];
+	mailbox->TDHR = ((uint32_t)data[7] << 24) | ((uint32_t)data[6] << 16) | ((uint32_t)data[5] << 8) | data[4];
+	mailbox->TIR = (id << CAN_TI0R_STID_Pos) | CAN_TI0R_TXRQ;
+
+	return tx_load_seq;
+}
+
+/**
+ * @brief Mailboxes de transmisión pendientes con el ID dado.
+ *
+ * @param id Standard identifier
+ * @return uint32_t Máscara de mailboxes pendientes con el ID (CAN_TX_MAILBOX0..2), 0 si ninguno
+ */
+static RAMFUNC uint32_t CAN_HW_Get_TxPending(uint32_t id)
+{
+	uint32_t tsr = hcan1.Instance->TSR;
+	uint32_t pending = 0;
+
+	for (uint32_t mailbox = 0; mailbox < CAN_HW_NUM_OF_TX_MAILBOXES; mailbox++)
+	{
+		if ((tsr & (CAN_TSR_TME0 << mailbox)) == 0U
+			&& ((hcan1.Instance->sTxMailBox[mailbox].TIR & CAN_TI0R_STID) >> CAN_TI0R_STID_Pos) == id)
+		{
+			pending |= CAN_TX_MAILBOX0 << mailbox;
+		}
+	}
+
+	return pending;
+}
+
+/**
+ * @brief Descarta de la cola de transmisión los mensajes con el ID dado.
+ *
+ * Debe llamarse con interrupciones deshabilitadas.
+ *
+ * @param id Standard identifier
+ * @retval None
+ */
+static RAMFUNC void CAN_HW_Remove_Queued(uint32_t id)
+{
+	uint32_t count = 0;
+
+	for (uint32_t i = 0; i < tx_queue.count; i++)
+	{
+		if (tx_queue.entries[i].id != id)
+		{
+			tx_queue.entries[count++] = tx_queue.entries[i];
+		}
+	}
+
+	tx_queue.count = count;
+	tx_queue_stats.depth = count;
+}
+
+/**
+ * @brief Transmisión completa de un mailbox.
+ *
+ * Si el mailbox transmitió el frame express en espera, registra sus latencias. El frame se
+ * identifica por el token de su carga y no por el ID: un mensaje anterior del mismo ID cuyo
+ * aborto llegó tarde (ya estaba en el bus) no cuenta como el frame express. Luego carga el
+ * siguiente mensaje de la cola.
+ *
+ * @param mailbox Mailbox de transmisión (0 a 2)
+ * @retval None
+ */
+static RAMFUNC void CAN_HW_Tx_Complete(uint32_t mailbox)
+{
+	uint32_t primask = __get_PRIMASK();
+
+	/* CAN_HW_Send_Express puede llamarse desde una interrupción de mayor prioridad */
+	__disable_irq();
+
+	if (express_pending && express_token != 0U && tx_mailbox_token[mailbox] == express_token)
+	{
+		uint32_t now_us = TIMEBASE_Get_TimeUs();
+		uint32_t latency_us = now_us - express_detect_us;
+		uint32_t request_latency_us = now_us - express_request_us;
+
+		express_pending = false;
+
+		express_stats.sent++;
+		express_stats.latency_last_us = latency_us;
+		express_stats.request_latency_last_us = request_latency_us;
+
+		if (latency_us > express_stats.latency_max_us)
+		{
+			express_stats.latency_max_us = latency_us;
+		}
+
+		if (request_latency_us > express_stats.request_latency_max_us)
+		{
+			express_stats.request_latency_max_us = request_latency_us;
+		}
+	}
+
+	CAN_HW_Feed_TxMailboxes();
+
+	__set_PRIMASK(primask);
+}
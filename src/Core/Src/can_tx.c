@@ -0,0 +1,362 @@
+/**
+ * @file can_tx.c
+ * @author Subgrupo Control y Periféricos - Elektron Motorsports
+ * @brief Planificador de transmisión CAN de tarjeta Control
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/***********************************************************************************************************************
+ * Included files
+ **********************************************************************************************************************/
+
+#include "can_tx.h"
+
+/***********************************************************************************************************************
+ * Private macros
+ **********************************************************************************************************************/
+
+/** @brief Tiempo [ms] antes de reintentar un frame que no entró a la cola de transmisión */
+#define CAN_TX_RETRY_MS                 CAN_TX_SLOT_MS
+
+/** @brief Entrada de tabla de planificación para num_of_signals variables contiguas del bus de salida CAN desde field */
+#define CAN_TX_ENTRY(id_name, field, num_of_signals, period_ms) \
+    {CAN_ID_##id_name, offsetof(typedef_bus2_t, field), num_of_signals, period_ms, \
+     CAN_TX_OFFSET_MS_##id_name, CAN_TX_MIN_GAP_MS_##id_name}
+
+/***********************************************************************************************************************
+ * Private types declarations
+ **********************************************************************************************************************/
+
+/**
+ * @brief Entrada de tabla de planificación de transmisión CAN
+ *
+ */
+typedef struct
+{
+    uint32_t    id;             /**< Standard identifier */
+    uint8_t     offset;         /**< Offset de la primera variable en typedef_bus2_t */
+    uint8_t     length;         /**< Bytes del payload */
+    uint16_t    period_ms;      /**< Máximo silencio (heartbeat) */
+    uint16_t    offset_ms;      /**< Desfase del primer heartbeat */
+    uint16_t    min_gap_ms;     /**< Intervalo mínimo entre transmisiones por cambio de valor */
+} can_tx_schedule_t;
+
+/**
+ * @brief Estado de transmisión de un frame de salida
+ *
+ */
+typedef struct
+{
+    uint32_t    heartbeat_ms;                       /**< Tick [ms] del siguiente heartbeat */
+    uint32_t    hold_until_ms;                      /**< Tick [ms] desde el que se puede transmitir un cambio */
+    uint32_t    last_send_ms;                       /**< Tick [ms] de la última transmisión */
+    bool        sent;                               /**< Se ha transmitido al menos una vez */
+    bool        deferred;                           /**< Hay un cambio retrasado por el intervalo mínimo */
+    uint8_t     last_payload[PAYLOAD_MAX_LENGTH];   /**< Último payload transmitido */
+} can_tx_state_t;
+
+/***********************************************************************************************************************
+ * Private variables definitions
+ **********************************************************************************************************************/
+
+#define CAN_TX_SCHEDULE_PARAMS(id_name, offset_ms, min_gap_ms) \
+    CAN_TX_OFFSET_MS_##id_name = offset_ms, \
+    CAN_TX_MIN_GAP_MS_##id_name = min_gap_ms,
+
+/** @brief Desfase e intervalo mínimo de cada frame de salida (ver CAN_TX_SCHEDULE) */
+enum
+{
+    CAN_TX_SCHEDULE(CAN_TX_SCHEDULE_PARAMS)
+};
+
+#undef CAN_TX_SCHEDULE_PARAMS
+
+#define CAN_TX_SCHEDULE_ENTRY(module, id_name, id, dir, fifo, field, type, decode, dest, scale, offset, period_ms) \
+    CAN_SIGNAL_IF_LEGACY(module, CAN_SIGNAL_IF_TX(dir, [kTX_FRAME_##id_name] = \
+        CAN_TX_ENTRY(id_name, field, sizeof(type), period_ms),))
+
+#define CAN_TX_PACKED_SCHEDULE_ENTRY(module, id_name, id, dir, fifo, first_id_name, first_field) \
+    CAN_SIGNAL_IF_PACKED(module, CAN_SIGNAL_IF_TX(dir, [kTX_FRAME_##id_name] = \
+        CAN_TX_ENTRY(id_name, first_field, CAN_MODULE_NUM_OF_SIGNALS(module, TX), CAN_TX_PACKED_PERIOD_MS),))
+
+/** @brief Tabla de planificación de transmisión CAN, generada del registro de señales CAN */
+static const can_tx_schedule_t can_tx_schedule[kTX_FRAME_COUNT] =
+{
+    CAN_SIGNALS(CAN_TX_SCHEDULE_ENTRY)
+
+    CAN_PACKED_FRAMES(CAN_TX_PACKED_SCHEDULE_ENTRY)
+};
+
+#undef CAN_TX_SCHEDULE_ENTRY
+#undef CAN_TX_PACKED_SCHEDULE_ENTRY
+
+_Static_assert(sizeof(typedef_bus2_t) <= PAYLOAD_MAX_LENGTH, "El bus de salida CAN no cabe en un frame empaquetado");
+
+/** @brief Estado de transmisión de cada frame de salida */
+static can_tx_state_t can_tx_state[kTX_FRAME_COUNT];
+
+/** @brief Estadísticas de transmisión de cada frame de salida */
+static can_tx_stats_t can_tx_stats[kTX_FRAME_COUNT];
+
+/** @brief Frames CAN que no se pudieron transmitir */
+static uint32_t can_tx_errors = 0;
+
+/** @brief El estado de transmisión de los frames de salida fue inicializado */
+static bool can_tx_initialized = false;
+
+/***********************************************************************************************************************
+ * Private functions prototypes
+ **********************************************************************************************************************/
+
+static void CAN_TX_Init_State(uint32_t now_ms);
+
+static void CAN_TX_Update_State(can_tx_frame_t frame, uint32_t now_ms);
+
+/***********************************************************************************************************************
+ * Public functions implementation
+ **********************************************************************************************************************/
+
+/**
+ * @brief Función principal del planificador de transmisión CAN.
+ *
+ * Transmite los frames de salida cuyo valor cambió (respetando su intervalo mínimo) y los
+ * frames que llegaron a su máximo silencio (heartbeat). Se llama en cada pasada del loop
+ * principal, para transmitir un cambio sin esperar un slot de transmisión. Un frame que no
+ * entró a la cola de transmisión se reintenta después de CAN_TX_RETRY_MS.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param now_ms Tick actual [ms]
+ * @retval None
+ */
+void CAN_TX_Process(uint32_t now_ms)
+{
+    if (!can_tx_initialized)
+    {
+        CAN_TX_Init_State(now_ms);
+    }
+
+    for (uint32_t i = 0; i < kTX_FRAME_COUNT; i++)
+    {
+        const can_tx_schedule_t *schedule = &can_tx_schedule[i];
+        can_tx_state_t *state = &can_tx_state[i];
+        const uint8_t *payload = (const uint8_t *)&bus_can_output + schedule->offset;
+        bool heartbeat = (int32_t)(now_ms - state->heartbeat_ms) >= 0;
+        bool changed = memcmp(payload, state->last_payload, schedule->length) != 0;
+
+        if (!heartbeat && !changed)
+        {
+            continue;
+        }
+
+        if ((int32_t)(now_ms - state->hold_until_ms) < 0)
+        {
+            /* Cambio dentro del intervalo mínimo: se transmite al terminar el intervalo */
+            if (changed && !state->deferred)
+            {
+                state->deferred = true;
+                can_tx_stats[i].deferred++;
+            }
+
+            continue;
+        }
+
+        if (CAN_TX_Send_Frame(schedule->id, payload, schedule->length) != CAN_STATUS_OK)
+        {
+            state->heartbeat_ms = now_ms + CAN_TX_RETRY_MS;
+            state->hold_until_ms = now_ms + CAN_TX_RETRY_MS;
+
+            continue;
+        }
+
+        memcpy(state->last_payload, payload, schedule->length);
+
+        if (changed)
+        {
+            can_tx_stats[i].events++;
+        }
+        else
+        {
+            can_tx_stats[i].heartbeats++;
+        }
+
+        CAN_TX_Update_State((can_tx_frame_t)i, now_ms);
+    }
+}
+
+/**
+ * @brief Transmite inmediatamente todos los frames de salida de un bus de salida CAN.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param bus_can_output Puntero a estructura de tipo typedef_bus2_t (bus de salida CAN)
+ * @retval None
+ */
+void CAN_TX_Send_All(const typedef_bus2_t *bus_can_output)
+{
+    for (uint32_t i = 0; i < kTX_FRAME_COUNT; i++)
+    {
+        const can_tx_schedule_t *schedule = &can_tx_schedule[i];
+        const uint8_t *payload = (const uint8_t *)bus_can_output + schedule->offset;
+
+        if (CAN_TX_Send_Frame(schedule->id, payload, schedule->length) == CAN_STATUS_OK)
+        {
+            memcpy(can_tx_state[i].last_payload, payload, schedule->length);
+
+            can_tx_stats[i].forced++;
+            CAN_TX_Update_State((can_tx_frame_t)i, HAL_GetTick());
+        }
+    }
+}
+
+/**
+ * @brief Transmite de inmediato un frame de salida por el camino express (mailbox reservado).
+ *
+ * Para eventos de latencia crítica (autokill): no espera al planificador de transmisión ni
+ * a la cola de transmisión CAN. El payload se toma del bus de salida CAN y se registra como
+ * transmitido, para que el planificador no lo repita como cambio de valor.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param frame Frame de salida
+ * @param detect_us Tiempo [us] de recepción del frame CAN que originó el evento (latencia de detección)
+ * @return can_status_t CAN_STATUS_ERROR si el frame no se pudo transmitir
+ */
+can_status_t CAN_TX_Send_Express(can_tx_frame_t frame, uint32_t detect_us)
+{
+    const can_tx_schedule_t *schedule = &can_tx_schedule[frame];
+    const uint8_t *payload = (const uint8_t *)&bus_can_output + schedule->offset;
+
+    if (CAN_HW_Send_Express(schedule->id, schedule->length, payload, detect_us) != CAN_STATUS_OK)
+    {
+        can_tx_errors++;
+
+        return CAN_STATUS_ERROR;
+    }
+
+    memcpy(can_tx_state[frame].last_payload, payload, schedule->length);
+
+    can_tx_stats[frame].forced++;
+    CAN_TX_Update_State(frame, HAL_GetTick());
+
+    return CAN_STATUS_OK;
+}
+
+/**
+ * @brief Transmite un frame CAN.
+ *
+ * Los frames que no se pueden transmitir se cuentan en CAN_TX_Get_ErrorCount.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param id Standard identifier
+ * @param payload Datos a transmitir
+ * @param length Número de bytes a transmitir
+ * @return can_status_t CAN_STATUS_ERROR si el frame no se pudo transmitir
+ */
+can_status_t CAN_TX_Send_Frame(uint32_t id, const uint8_t *payload, uint8_t length)
+{
+    can_obj.Frame.id = id;
+    can_obj.Frame.payload_length = length;
+    memcpy(can_obj.Frame.payload_buff, payload, length);
+
+    if (CAN_API_Send_Message(&can_obj) != CAN_STATUS_OK)
+    {
+        can_tx_errors++;
+
+        return CAN_STATUS_ERROR;
+    }
+
+    return CAN_STATUS_OK;
+}
+
+/**
+ * @brief Estadísticas de transmisión de un frame de salida.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param frame Frame de salida
+ * @return const can_tx_stats_t* Estadísticas del frame
+ */
+const can_tx_stats_t *CAN_TX_Get_Stats(can_tx_frame_t frame)
+{
+    return &can_tx_stats[frame];
+}
+
+/**
+ * @brief Número de frames CAN que no se pudieron transmitir.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param None
+ * @return uint32_t Frames no transmitidos
+ */
+uint32_t CAN_TX_Get_ErrorCount(void)
+{
+    return can_tx_errors;
+}
+
+/***********************************************************************************************************************
+ * Private functions implementation
+ **********************************************************************************************************************/
+
+/**
+ * @brief Inicializa el tiempo del primer heartbeat de cada frame de salida.
+ *
+ * @param now_ms Tick actual [ms]
+ * @retval None
+ */
+static void CAN_TX_Init_State(uint32_t now_ms)
+{
+    for (uint32_t i = 0; i < kTX_FRAME_COUNT; i++)
+    {
+        can_tx_state[i].heartbeat_ms = now_ms + can_tx_schedule[i].offset_ms;
+        can_tx_state[i].hold_until_ms = now_ms;
+        can_tx_stats[i].interval_min_ms = UINT32_MAX;
+    }
+
+    can_tx_initialized = true;
+}
+
+/**
+ * @brief Actualiza estado y estadísticas de un frame de salida después de transmitirlo.
+ *
+ * Reinicia el máximo silencio y el intervalo mínimo desde la transmisión.
+ *
+ * @param frame Frame de salida
+ * @param now_ms Tick actual [ms]
+ * @retval None
+ */
+static void CAN_TX_Update_State(can_tx_frame_t frame, uint32_t now_ms)
+{
+    const can_tx_schedule_t *schedule = &can_tx_schedule[frame];
+    can_tx_state_t *state = &can_tx_state[frame];
+    can_tx_stats_t *stats = &can_tx_stats[frame];
+
+    if (state->sent)
+    {
+        uint32_t interval = now_ms - state->last_send_ms;
+
+        if (interval < stats->interval_min_ms)
+        {
+            stats->interval_min_ms = interval;
+        }
+
+        if (interval > stats->interval_max_ms)
+        {
+            stats->interval_max_ms = interval;
+        }
+
+        stats->interval_sum_ms += interval;
+    }
+
+    state->sent = true;
+    state->deferred = false;
+    state->last_send_ms = now_ms;
+    state->heartbeat_ms = now_ms + schedule->period_ms;
+    state->hold_until_ms = now_ms + schedule->min_gap_ms;
+}
@@ -15,36 +15,97 @@
 
 #include "decode_data.h"
 
+#include "can_app.h"
+
 /***********************************************************************************************************************
- * Private variables definitions
+ * Private macros
  **********************************************************************************************************************/
 
-/** @brief Bandera para ejecutar bloque de decodificación de datos */
-decode_status_t flag_decodificar = NO_DECODIFICA;
+/*
+ * Decodificación de una señal según su tipo de decodificación en el registro de señales
+ * CAN (can_def.h). Cada señal RX expande a una sola asignación o switch, igual que la
+ * versión escrita a mano, que solo se ejecuta si su bit está en la máscara dirty.
+ */
+
+/** @brief Variable analógica: dest = field * scale + offset */
+#define DECODE_ANALOG(field, dest, scale, offset) \
+    bus_data.dest = ((rx_var_t)bus_can_input.field * (scale)) + (offset);
+
+/** @brief Variable de info de módulo (_ok) */
+#define DECODE_MODULE_INFO(field, dest, scale, offset) \
+    switch (bus_can_input.field) \
+    { \
+    case CAN_VALUE_MODULE_OK: \
+        bus_data.dest = kMODULE_INFO_OK; \
+        break; \
+    case CAN_VALUE_MODULE_ERROR: \
+        bus_data.dest = kMODULE_INFO_ERROR; \
+        break; \
+    }
+
+/** @brief Botones de modos de manejo */
+#define DECODE_BTN(field, dest, scale, offset) \
+    switch (bus_can_input.field) \
+    { \
+    case CAN_VALUE_BTN_NONE: \
+        bus_data.dest = kBTN_NONE; \
+        break; \
+    case CAN_VALUE_BTN_ECO: \
+        bus_data.dest = kBTN_ECO; \
+        break; \
+    case CAN_VALUE_BTN_NORMAL: \
+        bus_data.dest = kBTN_NORMAL; \
+        break; \
+    case CAN_VALUE_BTN_SPORT: \
+        bus_data.dest = kBTN_SPORT; \
+        break; \
+    }
+
+/** @brief Estado de hombre muerto */
+#define DECODE_HOMBRE_MUERTO(field, dest, scale, offset) \
+    switch (bus_can_input.field) \
+    { \
+    case CAN_VALUE_HOMBRE_MUERTO_ON: \
+        bus_data.dest = kHOMBRE_MUERTO_ON; \
+        break; \
+    case CAN_VALUE_HOMBRE_MUERTO_OFF: \
+        bus_data.dest = kHOMBRE_MUERTO_OFF; \
+        break; \
+    }
 
-/* Puntero a estructura de tipo rx_peripherals_vars_t que contiene los valores de las variables decodificadas de Periféricos */
-static rx_peripherals_vars_t* Rx_Peripherals = &bus_data.Rx_Peripherals;
+/** @brief Señal sin decodificación */
+#define DECODE_NONE(field, dest, scale, offset)
 
-/* Puntero a estructura de tipo rx_bms_vars_t que contiene los valores de las variables decodificadas de BMS */
-static rx_bms_vars_t* Rx_Bms = &bus_data.Rx_Bms;
+/** @brief Expande la decodificación de una señal del registro de señales CAN */
+#define DECODE_SIGNAL(module, id_name, id, dir, fifo, field, type, decode, dest, scale, offset, period_ms) \
+    CAN_SIGNAL_IF_RX(dir, \
+    if (dirty & RX_SIGNAL_MASK(kRX_SIGNAL_##id_name)) \
+    { \
+        DECODE_##decode(field, dest, scale, offset) \
+    })
 
-/* Puntero a estructura de tipo rx_dcdc_vars_t que contiene los valores de las variables decodificadas de DCDC */
-static rx_dcdc_vars_t* Rx_Dcdc = &bus_data.Rx_Dcdc;
+/***********************************************************************************************************************
+ * Private variables definitions
+ **********************************************************************************************************************/
 
-/* Puntero a estructura de tipo rx_inversor_vars_t que contiene los valores de las variables decodificadas de Inversor */
-static rx_inversor_vars_t* Rx_Inversor = &bus_data.Rx_Inversor;
+/** @brief Variables decodificadas con valor nuevo pendientes de consulta por cada etapa (al inicio, todas) */
+static uint32_t decode_updated_signals[kDECODE_CONSUMER_COUNT] =
+{
+    [kDECODE_CONSUMER_MONITORING]   = RX_SIGNAL_ALL_MASK,
+    [kDECODE_CONSUMER_RAMPA_PEDAL]  = RX_SIGNAL_ALL_MASK,
+};
 
 /***********************************************************************************************************************
  * Private functions prototypes
  **********************************************************************************************************************/
 
-static void DECODE_DATA_Decode_Bms(void);
+static void DECODE_DATA_Decode_Bms(uint32_t dirty);
 
-static void DECODE_DATA_Decode_Dcdc(void);
+static void DECODE_DATA_Decode_Dcdc(uint32_t dirty);
 
-static void DECODE_DATA_Decode_Inversor(void);
+static void DECODE_DATA_Decode_Inversor(uint32_t dirty);
 
-static void DECODE_DATA_Decode_Perifericos(void);
+static void DECODE_DATA_Decode_Perifericos(uint32_t dirty);
 
 /***********************************************************************************************************************
  * Public functions implementation
@@ -53,9 +114,10 @@ static void DECODE_DATA_Decode_Perifericos(void);
 /**
  * @brief Función principal de decodificación de datos de bus de recepción CAN.
  *
- * Decodifica los datos que se reciben desde el bus CAN. Los datos decodificados quedan
- * guardados en estructuras de tipo rx_bms_vars_t, rx_dcdc_vars_t, rx_inversor_vars_t,
- * y rx_peripherals_vars_t, en el bus de datos.
+ * Decodifica las variables del bus de recepción CAN que cambiaron de valor desde la última
+ * decodificación (can_rx_dirty_signals). Los datos decodificados quedan guardados en
+ * estructuras de tipo rx_bms_vars_t, rx_dcdc_vars_t, rx_inversor_vars_t, y
+ * rx_peripherals_vars_t, en el bus de datos.
  *
  * No es static, por lo que puede ser usada por otros archivos.
  *
@@ -64,15 +126,61 @@ static void DECODE_DATA_Decode_Perifericos(void);
  */
 void DECODE_DATA_Process(void)
 {
-    if (flag_decodificar == DECODIFICA)
+    /* can_rx_dirty_signals solo se escribe desde el loop principal (CAN_APP_Process) */
+    uint32_t dirty = can_rx_dirty_signals;
+
+    if (dirty == 0U)
     {
-    	DECODE_DATA_Decode_Bms();
-        DECODE_DATA_Decode_Dcdc();
-    	DECODE_DATA_Decode_Inversor();
-        DECODE_DATA_Decode_Perifericos();
+        return;
+    }
+
+    can_rx_dirty_signals = 0;
 
-        flag_decodificar = NO_DECODIFICA;
+    if (dirty & RX_MODULE_SIGNALS_MASK(BMS))
+    {
+        DECODE_DATA_Decode_Bms(dirty);
+    }
+
+    if (dirty & RX_MODULE_SIGNALS_MASK(DCDC))
+    {
+        DECODE_DATA_Decode_Dcdc(dirty);
     }
+
+    if (dirty & RX_MODULE_SIGNALS_MASK(INVERSOR))
+    {
+        DECODE_DATA_Decode_Inversor(dirty);
+    }
+
+    if (dirty & RX_MODULE_SIGNALS_MASK(PERIFERICOS))
+    {
+        DECODE_DATA_Decode_Perifericos(dirty);
+    }
+
+    for (uint32_t i = 0; i < kDECODE_CONSUMER_COUNT; i++)
+    {
+        decode_updated_signals[i] |= dirty;
+    }
+}
+
+/**
+ * @brief Variables decodificadas con valor nuevo desde la última consulta de una etapa.
+ *
+ * Cada etapa tiene su propia máscara, porque las etapas corren con periodos distintos al de
+ * la decodificación. En la primera consulta se reportan todas las variables. Se ejecuta desde
+ * SRAM porque la llama el camino de control (RAMPA_PEDAL_Process).
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param consumer Etapa que consulta
+ * @return uint32_t Máscara de variables con valor nuevo (un bit por rx_signal_t)
+ */
+RAMFUNC uint32_t DECODE_DATA_Take_UpdatedSignals(decode_consumer_t consumer)
+{
+    uint32_t updated = decode_updated_signals[consumer];
+
+    decode_updated_signals[consumer] = 0;
+
+    return updated;
 }
 
 /***********************************************************************************************************************
@@ -86,27 +194,11 @@ void DECODE_DATA_Process(void)
  * los datos en la estructura Rx_Bms del tipo rx_bms_vars_t y que
  * se encuentra en el bus_data.
  *
+ * @param dirty Máscara de variables a decodificar
  */
-static void DECODE_DATA_Decode_Bms(void)
+static void DECODE_DATA_Decode_Bms(uint32_t dirty)
 {
-    /* Decodifica info de BMS */
-    switch (bus_can_input.bms_ok)
-    {
-    case CAN_VALUE_MODULE_OK:
-    	Rx_Bms->bms_ok = kMODULE_INFO_OK;
-        break;
-    case CAN_VALUE_MODULE_ERROR:
-    	Rx_Bms->bms_ok = kMODULE_INFO_ERROR;
-        break;
-    }
-
-    /* Decodifica las variables analógicas de BMS */
-    Rx_Bms->voltaje = (rx_var_t)bus_can_input.voltaje_bms;
-    Rx_Bms->corriente = (rx_var_t)bus_can_input.corriente_bms;
-    Rx_Bms->voltaje_min_celda = (rx_var_t)bus_can_input.voltaje_min_celda_bms;
-    Rx_Bms->potencia = (rx_var_t)bus_can_input.potencia_bms;
-    Rx_Bms->t_max = (rx_var_t)bus_can_input.t_max_bms;
-    Rx_Bms->nivel_bateria = (rx_var_t)bus_can_input.nivel_bateria_bms;
+    CAN_SIGNALS_BMS(DECODE_SIGNAL)
 }
 
 /**
@@ -116,25 +208,11 @@ static void DECODE_DATA_Decode_Bms(void)
  * los datos en la estructura Rx_Dcdc del tipo rx_dcdc_vars_t y que
  * se encuentra en el bus_data.
  *
+ * @param dirty Máscara de variables a decodificar
  */
-static void DECODE_DATA_Decode_Dcdc(void)
+static void DECODE_DATA_Decode_Dcdc(uint32_t dirty)
 {
-    /* Decodifica info de DCDC */
-    switch (bus_can_input.dcdc_ok)
-    {
-    case CAN_VALUE_MODULE_OK:
-    	Rx_Dcdc->dcdc_ok = kMODULE_INFO_OK;
-        break;
-    case CAN_VALUE_MODULE_ERROR:
-    	Rx_Dcdc->dcdc_ok = kMODULE_INFO_ERROR;
-        break;
-    }
-
-    /* Decodifica las variables analógicas de DCDC */
-    Rx_Dcdc->voltaje_bateria = (rx_var_t)bus_can_input.voltaje_bateria_dcdc;
-    Rx_Dcdc->voltaje_salida = (rx_var_t)bus_can_input.voltaje_salida_dcdc;
-    Rx_Dcdc->t_max = (rx_var_t)bus_can_input.t_max_dcdc;
-    Rx_Dcdc->potencia = (rx_var_t)bus_can_input.potencia_dcdc;
+    CAN_SIGNALS_DCDC(DECODE_SIGNAL)
 }
 
 /**
@@ -144,69 +222,23 @@ static void DECODE_DATA_Decode_Dcdc(void)
  * los datos en la estructura Rx_Inversor del tipo rx_inversor_vars_t y
  * que se encuentra en el bus_data.
  *
+ * @param dirty Máscara de variables a decodificar
  */
-static void DECODE_DATA_Decode_Inversor(void)
+static void DECODE_DATA_Decode_Inversor(uint32_t dirty)
 {
-    /* Decodifica info de Inversor */
-    switch (bus_can_input.inversor_ok)
-    {
-    case CAN_VALUE_MODULE_OK:
-    	Rx_Inversor->inversor_ok = kMODULE_INFO_OK;
-        break;
-    case CAN_VALUE_MODULE_ERROR:
-    	Rx_Inversor->inversor_ok = kMODULE_INFO_ERROR;
-        break;
-    }
-
-	/* Decodifica las variables analógicas de Inversor */
-    Rx_Inversor->velocidad = (rx_var_t)bus_can_input.velocidad_inv;
-    Rx_Inversor->V = (rx_var_t)bus_can_input.V_inv;
-    Rx_Inversor->I = (rx_var_t)bus_can_input.I_inv;
-    Rx_Inversor->temp_max = (rx_var_t)bus_can_input.temp_max_inv;
-    Rx_Inversor->temp_motor = (rx_var_t)bus_can_input.temp_motor_inv;
-    Rx_Inversor->potencia = (rx_var_t)bus_can_input.potencia_inv;
+    CAN_SIGNALS_INVERSOR(DECODE_SIGNAL)
 }
 
-static void DECODE_DATA_Decode_Perifericos(void)
+/**
+ * @brief Decodifica los datos de Periféricos
+ *
+ * Decodifica las variables que se reciben de periféricos por CAN y guarda
+ * los datos en la estructura Rx_Peripherals del tipo rx_peripherals_vars_t
+ * y que se encuentra en el bus_data.
+ *
+ * @param dirty Máscara de variables a decodificar
+ */
+static void DECODE_DATA_Decode_Perifericos(uint32_t dirty)
 {
-    /* Decodifica info de Perifericos */
-    switch (bus_can_input.perifericos_ok)
-    {
-    case CAN_VALUE_MODULE_OK:
-        Rx_Peripherals->perifericos_ok = kMODULE_INFO_OK;
-        break;
-    case CAN_VALUE_MODULE_ERROR:
-        Rx_Peripherals->perifericos_ok = kMODULE_INFO_ERROR;
-        break;
-    }
-
-	/* Decodifica botones de modos de manejo */
-    switch (bus_can_input.botones_cambio_estado)
-    {
-    case CAN_VALUE_BTN_NONE:
-    	Rx_Peripherals->botones_cambio_estado = kBTN_NONE;
-        break;
-    case CAN_VALUE_BTN_ECO:
-    	Rx_Peripherals->botones_cambio_estado = kBTN_ECO;
-        break;
-    case CAN_VALUE_BTN_NORMAL:
-    	Rx_Peripherals->botones_cambio_estado = kBTN_NORMAL;
-        break;
-    case CAN_VALUE_BTN_SPORT:
-    	Rx_Peripherals->botones_cambio_estado = kBTN_SPORT;
-        break;
-    }
-
-    /* Decodifica estado de hombre muerto */
-    switch (bus_can_input.hombre_muerto)
-    {
-    case CAN_VALUE_HOMBRE_MUERTO_ON:
-        Rx_Peripherals->hombre_muerto = kHOMBRE_MUERTO_ON;
-        break;
-    case CAN_VALUE_HOMBRE_MUERTO_OFF:
-        Rx_Peripherals->hombre_muerto = kHOMBRE_MUERTO_OFF;
-    }
-
-    /* Decodifica las variables analógicas de Periféricos */
-    Rx_Peripherals->pedal = (rx_var_t)bus_can_input.pedal;
+    CAN_SIGNALS_PERIFERICOS(DECODE_SIGNAL)
 }
@@ -38,6 +38,14 @@ enum FailuresStates
 /** @brief Estado de la máquina de estados */
 static uint8_t failures_state = kCAUTION1;
 
+/** @brief La última pasada de la máquina de estados no hizo transición */
+static bool failures_settled = false;
+
+/** @brief Estado de los módulos BMS, DCDC e inversor en la última pasada de la máquina de estados */
+static module_status_t failures_last_bms_status;
+static module_status_t failures_last_dcdc_status;
+static module_status_t failures_last_inversor_status;
+
 /***********************************************************************************************************************
  * Private functions prototypes
  **********************************************************************************************************************/
@@ -50,6 +58,8 @@ static void FAILURES_Send_ControlInfo(module_info_t to_send, typedef_bus2_t* bus
 
 static void FAILURES_Send_Autokill(typedef_bus2_t* bus_can_output);
 
+static void FAILURES_Enter_Autokill(void);
+
 static bool FAILURES_Is_Autokill(void);
 
 /***********************************************************************************************************************
@@ -62,7 +72,9 @@ static bool FAILURES_Is_Autokill(void);
  * Determina estado general de cada uno de los modulos segun el estado de las
  * variables decodificadas.
  *
- * Llama a la función máquina de estados de fallas.
+ * Llama a la función máquina de estados de fallas. La máquina solo depende de su estado y del
+ * estado de los módulos, por lo que si ninguno cambió desde una pasada sin transición, la
+ * pasada se omite.
  *
  * No es static, por lo que puede ser usada por otros archivos.
  *
@@ -71,7 +83,24 @@ static bool FAILURES_Is_Autokill(void);
  */
 void FAILURES_Process(void)
 {
+    uint8_t state = failures_state;
+
+    if (failures_settled
+        && bus_data.bms_status == failures_last_bms_status
+        && bus_data.dcdc_status == failures_last_dcdc_status
+        && bus_data.inversor_status == failures_last_inversor_status)
+    {
+        return;
+    }
+
+    failures_last_bms_status = bus_data.bms_status;
+    failures_last_dcdc_status = bus_data.dcdc_status;
+    failures_last_inversor_status = bus_data.inversor_status;
+
     FAILURES_StateMachine();
+
+    /* Las salidas del nuevo estado se escriben en la siguiente pasada */
+    failures_settled = (failures_state == state);
 }
 
 /***********************************************************************************************************************
@@ -95,6 +124,8 @@ void FAILURES_Process(void)
  *
  * Escribe en la variable autokill del bus_can_output.
  *
+ * Transmite el frame de autokill por el camino express al entrar a AUTOKILL.
+ *
  */
 static void FAILURES_StateMachine(void)
 {
@@ -110,7 +141,7 @@ static void FAILURES_StateMachine(void)
 
         if (FAILURES_Is_Autokill()) 
         {
-            failures_state = kAUTOKILL;
+            FAILURES_Enter_Autokill();
         }
         else if (bus_data.bms_status == kMODULE_STATUS_PROBLEM
             || bus_data.dcdc_status == kMODULE_STATUS_PROBLEM
@@ -136,7 +167,7 @@ static void FAILURES_StateMachine(void)
 
         if (FAILURES_Is_Autokill()) 
         {
-            failures_state = kAUTOKILL;
+            FAILURES_Enter_Autokill();
         }
         else if (bus_data.bms_status == kMODULE_STATUS_PROBLEM
             || bus_data.dcdc_status == kMODULE_STATUS_PROBLEM
@@ -162,7 +193,7 @@ static void FAILURES_StateMachine(void)
 
         if (FAILURES_Is_Autokill()) 
         {
-            failures_state = kAUTOKILL;
+            FAILURES_Enter_Autokill();
         }
         else if ((bus_data.bms_status == kMODULE_STATUS_REGULAR || bus_data.bms_status == kMODULE_STATUS_OK)
             && (bus_data.dcdc_status == kMODULE_STATUS_REGULAR || bus_data.dcdc_status == kMODULE_STATUS_OK)
@@ -271,3 +302,31 @@ static void FAILURES_Send_Autokill(typedef_bus2_t* bus_can_output)
 {
     bus_can_output->autokill = CAN_VALUE_AUTOKILL_EVENT;
 }
+
+/**
+ * @brief Transición a estado AUTOKILL.
+ *
+ * Escribe la falla y el evento autokill en el bus de salida CAN y transmite de inmediato
+ * el frame de autokill por el camino express (mailbox reservado), sin esperar al
+ * planificador de transmisión CAN. La latencia del camino express se mide desde la
+ * recepción del último frame que cambió la variable de estado de un módulo en PROBLEM.
+ *
+ */
+static void FAILURES_Enter_Autokill(void)
+{
+    uint32_t status_signals = 0;
+
+    failures_state = kAUTOKILL;
+
+    if (bus_data.bms_status == kMODULE_STATUS_PROBLEM) status_signals |= RX_SIGNAL_MASK(kRX_SIGNAL_BMS_OK);
+
+    if (bus_data.dcdc_status == kMODULE_STATUS_PROBLEM) status_signals |= RX_SIGNAL_MASK(kRX_SIGNAL_DCDC_OK);
+
+    if (bus_data.inversor_status == kMODULE_STATUS_PROBLEM) status_signals |= RX_SIGNAL_MASK(kRX_SIGNAL_INVERSOR_OK);
+
+    /* Actualiza falla y variable autokill en bus de salida CAN */
+    FAILURES_Send_Failure(kFAILURE_AUTOKILL, &bus_can_output);
+    FAILURES_Send_Autokill(&bus_can_output);
+
+    (void)CAN_TX_Send_Express(CAN_TX_FRAME_AUTOKILL, CAN_APP_Get_SignalChangeUs(status_signals));
+}
@@ -22,66 +22,272 @@
 /** @brief Duración de blink de los LEDs en ms */
 #define BLINK_TIME_MS                  	250U
 
-/** @brief Duración para apagado de los LEDs en ms */
-#define LEDS_TURNOFF_TIME_MS           	3000U
+/** @brief Duración de blink de los LEDs en inicialización en ms */
+#define INIT_BLINK_TIME_MS              200U
 
-/** @brief Duración para apagado del buzzer en ms */
+/** @brief Duración del buzzer en fin de inicialización en ms */
 #define BUZZER_TURNOFF_TIME_MS			2000U
 
+/** @brief Número de ticks de un paso de patrón (0: paso permanente) */
+#define INDICATORS_TICKS(duration_ms)   (((duration_ms) + INDICATORS_TICK_MS - 1U) / INDICATORS_TICK_MS)
+
+/** @brief Número de pasos de un patrón */
+#define INDICATORS_STEPS(steps)         (sizeof(steps) / sizeof((steps)[0]))
+
+/** @brief Buzzer encendido en un paso de patrón */
+#define BUZZER_ON                       1U
+
+/** @brief Buzzer apagado en un paso de patrón */
+#define BUZZER_OFF                      0U
+
+/***********************************************************************************************************************
+ * Private types declarations
+ **********************************************************************************************************************/
+
+/**
+ * @brief Paso de un patrón de LEDs o buzzer
+ *
+ */
+typedef struct
+{
+    uint16_t    duration_ms;        /**< Duración del paso (0: permanente) */
+    uint8_t     value;              /**< LEDs encendidos (LED_MASK) o BUZZER_ON/BUZZER_OFF */
+} indicators_step_t;
+
+/**
+ * @brief Patrón de LEDs o buzzer: secuencia de pasos
+ *
+ * Un patrón cíclico se repite indefinidamente (patrón de fondo); uno no cíclico se reproduce
+ * una vez sobre el patrón de fondo, que se retoma al terminar.
+ *
+ */
+typedef struct
+{
+    const indicators_step_t *steps; /**< Pasos del patrón */
+    uint8_t     count;              /**< Número de pasos */
+    bool        loop;               /**< Patrón cíclico */
+} indicators_pattern_t;
+
+/**
+ * @brief Canal de indicadores (LEDs o buzzer)
+ *
+ */
+typedef struct
+{
+    int32_t     (*write)(uint32_t value);           /**< Escritura del valor en hardware */
+    const indicators_pattern_t *pattern;            /**< Patrón en reproducción */
+    const indicators_pattern_t *background;         /**< Patrón de fondo */
+    uint8_t     step;                               /**< Paso actual del patrón */
+    uint16_t    ticks;                              /**< Ticks restantes del paso actual */
+    uint8_t     value;                              /**< Último valor escrito en hardware */
+} indicators_channel_t;
+
+/**
+ * @brief Canales de indicadores
+ *
+ */
+typedef enum
+{
+    kCHANNEL_LEDS = 0,
+    kCHANNEL_BUZZER,
+
+    kCHANNEL_COUNT
+} indicators_channel_id_t;
+
 /***********************************************************************************************************************
  * Private variables definitions
  **********************************************************************************************************************/
 
+/** @brief Pasos permanentes, uno por cada combinación de LEDs (o buzzer apagado/encendido) */
+static const indicators_step_t steady_steps[LED_ALL_MASK + 1U] =
+{
+    {0, 0}, {0, 1}, {0, 2}, {0, 3}, {0, 4}, {0, 5}, {0, 6}, {0, 7},
+};
+
+/** @brief Patrones permanentes, uno por cada combinación de LEDs (o buzzer apagado/encendido) */
+static const indicators_pattern_t steady_patterns[LED_ALL_MASK + 1U] =
+{
+    {&steady_steps[0], 1, true}, {&steady_steps[1], 1, true}, {&steady_steps[2], 1, true}, {&steady_steps[3], 1, true},
+    {&steady_steps[4], 1, true}, {&steady_steps[5], 1, true}, {&steady_steps[6], 1, true}, {&steady_steps[7], 1, true},
+};
+
+/** @brief LEDs: inicialización completada, tres parpadeos */
+static const indicators_step_t led_init_steps[] =
+{
+    {INIT_BLINK_TIME_MS, LED_ALL_MASK}, {INIT_BLINK_TIME_MS, 0},
+    {INIT_BLINK_TIME_MS, LED_ALL_MASK}, {INIT_BLINK_TIME_MS, 0},
+    {INIT_BLINK_TIME_MS, LED_ALL_MASK}, {INIT_BLINK_TIME_MS, 0},
+};
+
+/** @brief LEDs: fin de inicialización (handshake con módulos), 3 s parpadeando */
+static const indicators_step_t led_startup_steps[] =
+{
+    {BLINK_TIME_MS, 0}, {BLINK_TIME_MS, LED_ALL_MASK},
+    {BLINK_TIME_MS, 0}, {BLINK_TIME_MS, LED_ALL_MASK},
+    {BLINK_TIME_MS, 0}, {BLINK_TIME_MS, LED_ALL_MASK},
+    {BLINK_TIME_MS, 0}, {BLINK_TIME_MS, LED_ALL_MASK},
+    {BLINK_TIME_MS, 0}, {BLINK_TIME_MS, LED_ALL_MASK},
+    {BLINK_TIME_MS, 0}, {BLINK_TIME_MS, LED_ALL_MASK},
+};
+
+/** @brief Buzzer: fin de inicialización */
+static const indicators_step_t buzzer_startup_steps[] =
+{
+    {BUZZER_TURNOFF_TIME_MS, BUZZER_ON},
+};
+
+/** @brief Buzzer: falla CAUTION1, un pitido cada 2 s */
+static const indicators_step_t buzzer_caution1_steps[] =
+{
+    {100, BUZZER_ON}, {1900, BUZZER_OFF},
+};
+
+/** @brief Buzzer: falla CAUTION2, un pitido cada 500 ms */
+static const indicators_step_t buzzer_caution2_steps[] =
+{
+    {100, BUZZER_ON}, {400, BUZZER_OFF},
+};
+
+/** @brief Buzzer: falla AUTOKILL, blink de 250 ms */
+static const indicators_step_t buzzer_autokill_steps[] =
+{
+    {BLINK_TIME_MS, BUZZER_ON}, {BLINK_TIME_MS, BUZZER_OFF},
+};
+
+static const indicators_pattern_t led_init_pattern =
+    {led_init_steps, INDICATORS_STEPS(led_init_steps), false};
+
+static const indicators_pattern_t led_startup_pattern =
+    {led_startup_steps, INDICATORS_STEPS(led_startup_steps), false};
+
+static const indicators_pattern_t buzzer_startup_pattern =
+    {buzzer_startup_steps, INDICATORS_STEPS(buzzer_startup_steps), false};
+
+/** @brief Patrón de buzzer de cada nivel de falla */
+static const indicators_pattern_t buzzer_failure_patterns[] =
+{
+    [kFAILURE_OK]       = {&steady_steps[BUZZER_OFF], 1, true},
+    [kFAILURE_CAUTION1] = {buzzer_caution1_steps, INDICATORS_STEPS(buzzer_caution1_steps), true},
+    [kFAILURE_CAUTION2] = {buzzer_caution2_steps, INDICATORS_STEPS(buzzer_caution2_steps), true},
+    [kFAILURE_AUTOKILL] = {buzzer_autokill_steps, INDICATORS_STEPS(buzzer_autokill_steps), true},
+};
+
+/** @brief LEDs de cada modo de manejo */
+static const uint8_t driving_mode_leds[] =
+{
+    [kDRIVING_MODE_ECO]     = LED_MASK(LED1),
+    [kDRIVING_MODE_NORMAL]  = LED_MASK(LED2),
+    [kDRIVING_MODE_SPORT]   = LED_MASK(LED3),
+};
+
+/** @brief Canales de indicadores. Los modifica el loop principal y la interrupción de TIM7 */
+static indicators_channel_t channels[kCHANNEL_COUNT] =
+{
+    [kCHANNEL_LEDS]     = {BSP_LED_Write,    &steady_patterns[0], &steady_patterns[0], 0, 0, 0},
+    [kCHANNEL_BUZZER]   = {BSP_BUZZER_Write, &steady_patterns[0], &steady_patterns[0], 0, 0, 0},
+};
+
+/** @brief LEDs de confirmación de módulos durante inicialización */
+static uint8_t modules_leds = 0;
+
 /***********************************************************************************************************************
  * Private functions prototypes
  **********************************************************************************************************************/
 
+static void INDICATORS_Play(indicators_channel_id_t channel, const indicators_pattern_t *pattern);
+static void INDICATORS_Set_Background(indicators_channel_id_t channel, const indicators_pattern_t *pattern);
+static void INDICATORS_Start_Pattern(indicators_channel_t *ch, const indicators_pattern_t *pattern);
+static void INDICATORS_Write(indicators_channel_t *ch);
+
 /***********************************************************************************************************************
  * Public functions implementation
  **********************************************************************************************************************/
 
 /**
- * @brief Función principal bloque generación de indicadores.
- * 
- * Por defecto, actualiza LEDs de acuerdo al modo de manejo actual.
+ * @brief Inicialización de los patrones de LEDs y buzzer.
+ *
+ * Inicia el patrón de inicialización de la tarjeta (tres parpadeos de los LEDs). Los LEDs y el
+ * buzzer deben estar inicializados (BSP).
  *
  * No es static, por lo que puede ser usada por otros archivos.
  *
  * @param None
  * @retval None
  */
-void INDICATORS_Process(void)
+void INDICATORS_Init(void)
 {
-	/*
-    if(bus_data.driving_mode == kDRIVING_MODE_ECO)
-    {
-        BSP_LED_On(LED1);
-        BSP_LED_Off(LED2);
-        BSP_LED_Off(LED3);
-    }
+    INDICATORS_Play(kCHANNEL_LEDS, &led_init_pattern);
+}
 
-    else if(bus_data.driving_mode == kDRIVING_MODE_NORMAL)
+/**
+ * @brief Avanza los patrones de LEDs y buzzer. Se llama desde la interrupción de TIM7,
+ * cada INDICATORS_TICK_MS.
+ *
+ * El hardware se escribe solo cuando cambia el valor de un canal.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param None
+ * @retval None
+ */
+void INDICATORS_Tick(void)
+{
+    for (uint32_t i = 0; i < kCHANNEL_COUNT; i++)
     {
-        BSP_LED_Off(LED1);
-        BSP_LED_On(LED2);
-        BSP_LED_Off(LED3);
-    }
+        indicators_channel_t *ch = &channels[i];
 
-    else if(bus_data.driving_mode == kDRIVING_MODE_SPORT)
-    {
-        BSP_LED_Off(LED1);
-        BSP_LED_Off(LED2);
-        BSP_LED_On(LED3);
-    }
+        /* Paso permanente o paso aún en curso */
+        if ((ch->ticks == 0U) || (--ch->ticks != 0U))
+        {
+            continue;
+        }
 
-    if(bus_data.failure == kFAILURE_AUTOKILL)
-    {
-        BSP_BUZZER_On();
+        ch->step++;
+
+        if (ch->step < ch->pattern->count)
+        {
+            ch->ticks = INDICATORS_TICKS(ch->pattern->steps[ch->step].duration_ms);
+        }
+        else if (ch->pattern->loop)
+        {
+            INDICATORS_Start_Pattern(ch, ch->pattern);
+        }
+        else
+        {
+            /* Fin de patrón no cíclico: se retoma el patrón de fondo */
+            INDICATORS_Start_Pattern(ch, ch->background);
+        }
 
-        // blink buzzer
+        INDICATORS_Write(ch);
     }
-    */
-	asm("nop");
+}
+
+/**
+ * @brief Función principal bloque generación de indicadores.
+ * 
+ * Selecciona el patrón de LEDs de acuerdo al modo de manejo actual y el patrón de buzzer de
+ * acuerdo al nivel de falla actual. Un patrón de fondo que no cambia sigue su secuencia, por
+ * lo que llamar a esta función no escribe hardware.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param None
+ * @retval None
+ */
+void INDICATORS_Process(void)
+{
+    uint32_t driving_mode = (uint32_t)bus_data.driving_mode;
+    uint32_t failure = (uint32_t)bus_data.failure;
+
+    /* Modo de manejo fuera de rango: LEDs apagados */
+    INDICATORS_Set_Background(kCHANNEL_LEDS, (driving_mode < INDICATORS_STEPS(driving_mode_leds))
+                                             ? &steady_patterns[driving_mode_leds[driving_mode]]
+                                             : &steady_patterns[0]);
+
+    /* Nivel de falla fuera de rango: se indica como la falla más grave */
+    INDICATORS_Set_Background(kCHANNEL_BUZZER, (failure < INDICATORS_STEPS(buzzer_failure_patterns))
+                                               ? &buzzer_failure_patterns[failure]
+                                               : &buzzer_failure_patterns[kFAILURE_AUTOKILL]);
 }
 
 /**
@@ -96,23 +302,28 @@ void INDICATORS_Update_ModulesLEDs(void)
 {
     if(bus_can_input.bms_ok == CAN_VALUE_MODULE_OK)
     {
-        BSP_LED_On(LED1);
+        modules_leds |= LED_MASK(LED1);
     }
 
     if(bus_can_input.dcdc_ok == CAN_VALUE_MODULE_OK)
     {
-        BSP_LED_On(LED2);
+        modules_leds |= LED_MASK(LED2);
     }
 
     if(bus_can_input.inversor_ok == CAN_VALUE_MODULE_OK)
     {
-        BSP_LED_On(LED3);
+        modules_leds |= LED_MASK(LED3);
     }
+
+    INDICATORS_Set_Background(kCHANNEL_LEDS, &steady_patterns[modules_leds]);
 }
 
 /**
  * @brief Indicación de que la tarjeta ha finalizado la inicialización.
  *
+ * Inicia el patrón de fin de inicialización (LEDs parpadeando y buzzer); no bloquea.
+ * Al terminar, los LEDs se apagan hasta que INDICATORS_Process selecciona su patrón.
+ *
  * No es static, por lo que puede ser usada por otros archivos.
  *
  * @param None
@@ -120,49 +331,98 @@ void INDICATORS_Update_ModulesLEDs(void)
  */
 void INDICATORS_Finish_StartUp(void)
 {
-    uint32_t tickstart;
+    INDICATORS_Set_Background(kCHANNEL_LEDS, &steady_patterns[0]);
 
-    uint32_t blink_tickstart;
+    INDICATORS_Play(kCHANNEL_LEDS, &led_startup_pattern);
+    INDICATORS_Play(kCHANNEL_BUZZER, &buzzer_startup_pattern);
+}
 
-    BSP_BUZZER_On();
+/***********************************************************************************************************************
+ * Private functions implementation
+ **********************************************************************************************************************/
 
-    /* Get ticks for the turn off time of LEDs and buzzer */
-    tickstart = HAL_GetTick();
+/**
+ * @brief Reproduce un patrón no cíclico sobre el patrón de fondo de un canal.
+ *
+ * @param channel Canal
+ * @param pattern Patrón
+ * @retval None
+ */
+static void INDICATORS_Play(indicators_channel_id_t channel, const indicators_pattern_t *pattern)
+{
+    indicators_channel_t *ch = &channels[channel];
+    uint32_t primask = __get_PRIMASK();
 
-    /* Ticks for the blinking of the LEDs */
-    blink_tickstart = tickstart;
+    __disable_irq();
 
-    BSP_LED_Off(LED1);
-    BSP_LED_Off(LED2);
-    BSP_LED_Off(LED3);
+    INDICATORS_Start_Pattern(ch, pattern);
+    INDICATORS_Write(ch);
 
-    while(1)
-    {
-        if((HAL_GetTick() - blink_tickstart) > BLINK_TIME_MS)
-        {
-            BSP_LED_Toggle(LED1);
-            BSP_LED_Toggle(LED2);
-            BSP_LED_Toggle(LED3);
+    __set_PRIMASK(primask);
+}
 
-            blink_tickstart = HAL_GetTick();
-        }
+/**
+ * @brief Cambia el patrón de fondo de un canal.
+ *
+ * Si el canal reproduce su patrón de fondo, el nuevo patrón inicia de inmediato; si reproduce
+ * un patrón no cíclico, el nuevo patrón inicia al terminar. Un patrón de fondo igual al actual
+ * no se reinicia.
+ *
+ * @param channel Canal
+ * @param pattern Patrón cíclico
+ * @retval None
+ */
+static void INDICATORS_Set_Background(indicators_channel_id_t channel, const indicators_pattern_t *pattern)
+{
+    indicators_channel_t *ch = &channels[channel];
+    uint32_t primask;
 
-        if((HAL_GetTick() - tickstart) > BUZZER_TURNOFF_TIME_MS)
-        {
-            BSP_BUZZER_Off();
-        }
+    if (ch->background == pattern)
+    {
+        return;
+    }
 
-        if((HAL_GetTick() - tickstart) > LEDS_TURNOFF_TIME_MS)
-        {
-            BSP_LED_Off(LED1);
-            BSP_LED_Off(LED2);
-            BSP_LED_Off(LED3);
+    primask = __get_PRIMASK();
+    __disable_irq();
 
-            break;
-        }
+    if (ch->pattern == ch->background)
+    {
+        INDICATORS_Start_Pattern(ch, pattern);
+        INDICATORS_Write(ch);
     }
+
+    ch->background = pattern;
+
+    __set_PRIMASK(primask);
 }
 
-/***********************************************************************************************************************
- * Private functions implementation
- **********************************************************************************************************************/
+/**
+ * @brief Inicia un patrón en su primer paso.
+ *
+ * @param ch Canal
+ * @param pattern Patrón
+ * @retval None
+ */
+static void INDICATORS_Start_Pattern(indicators_channel_t *ch, const indicators_pattern_t *pattern)
+{
+    ch->pattern = pattern;
+    ch->step = 0;
+    ch->ticks = INDICATORS_TICKS(pattern->steps[0].duration_ms);
+}
+
+/**
+ * @brief Escribe el valor del paso actual de un canal en hardware, solo si cambió.
+ *
+ * @param ch Canal
+ * @retval None
+ */
+static void INDICATORS_Write(indicators_channel_t *ch)
+{
+    uint8_t value = ch->pattern->steps[ch->step].value;
+
+    if (value != ch->value)
+    {
+        ch->value = value;
+        (void)ch->write(value);
+    }
+}
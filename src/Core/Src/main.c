@@ -47,7 +47,9 @@
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
 /* USER CODE BEGIN PFP */
-
+#if CLOCK_PROFILE == CLOCK_PROFILE_PERFORMANCE
+static void SystemClock_Config_Performance(void);
+#endif /* CLOCK_PROFILE */
 /* USER CODE END PFP */
 
 /* Private user code ---------------------------------------------------------*/
@@ -79,6 +81,10 @@ int main(void)
 
   /* USER CODE BEGIN SysInit */
 
+#if CLOCK_PROFILE == CLOCK_PROFILE_PERFORMANCE
+  SystemClock_Config_Performance();
+#endif /* CLOCK_PROFILE */
+
   /* USER CODE END SysInit */
 
   /* USER CODE BEGIN 2 */
@@ -147,6 +153,78 @@ void SystemClock_Config(void)
 
 /* USER CODE BEGIN 4 */
 
+#if CLOCK_PROFILE == CLOCK_PROFILE_PERFORMANCE
+/**
+ * @brief Perfil de reloj de rendimiento: HSE (8 MHz), PLL a 180 MHz con overdrive.
+ *
+ * SystemClock_Config (generada de Control.ioc) deja el perfil de bajo consumo. Esta función
+ * pasa SYSCLK a HSI, apaga el PLL para poder cambiar la escala de voltaje y lo reconfigura con
+ * HSE. Los prescalers de CAN y TIM7 se recalculan en USER CODE CAN1_Init 2 y TIM7_Init 2. El
+ * prefetch y los caches del acelerador ART los habilita HAL_Init (stm32f4xx_hal_conf.h).
+ *
+ * @param None
+ * @retval None
+ */
+static void SystemClock_Config_Performance(void)
+{
+  RCC_OscInitTypeDef RCC_OscInitStruct = {0};
+  RCC_ClkInitTypeDef RCC_ClkInitStruct = {0};
+
+  /* SYSCLK desde HSI mientras se reconfigura el PLL */
+  RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK|RCC_CLOCKTYPE_SYSCLK
+                              |RCC_CLOCKTYPE_PCLK1|RCC_CLOCKTYPE_PCLK2;
+  RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_HSI;
+  RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
+  RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV1;
+  RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
+
+  if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_2) != HAL_OK)
+  {
+    Error_Handler();
+  }
+
+  /* La escala de voltaje solo se puede cambiar con el PLL apagado */
+  RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_NONE;
+  RCC_OscInitStruct.PLL.PLLState = RCC_PLL_OFF;
+
+  if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
+  {
+    Error_Handler();
+  }
+
+  __HAL_PWR_VOLTAGESCALING_CONFIG(PWR_REGULATOR_VOLTAGE_SCALE1);
+
+  RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSE;
+  RCC_OscInitStruct.HSEState = RCC_HSE_ON;
+  RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
+  RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSE;
+  RCC_OscInitStruct.PLL.PLLM = 4;
+  RCC_OscInitStruct.PLL.PLLN = 180;
+  RCC_OscInitStruct.PLL.PLLP = RCC_PLLP_DIV2;
+  RCC_OscInitStruct.PLL.PLLQ = 8;
+  RCC_OscInitStruct.PLL.PLLR = 2;
+
+  if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
+  {
+    Error_Handler();
+  }
+
+  if (HAL_PWREx_EnableOverDrive() != HAL_OK)
+  {
+    Error_Handler();
+  }
+
+  RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
+  RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV4;
+  RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV2;
+
+  if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_5) != HAL_OK)
+  {
+    Error_Handler();
+  }
+}
+#endif /* CLOCK_PROFILE */
+
 /* USER CODE END 4 */
 
 /**
@@ -178,16 +178,41 @@ void MONITORING_Process(void)
  * @brief Modules Received Status
  *
  * Estado general de los módulos de acuerdo a las variables de estado de módulo recibidas. Sintetizan las variables
- * internas y los estados de falla definidos internamente por cada módulo del vehículo.
+ * internas y los estados de falla definidos internamente por cada módulo del vehículo. Un módulo que deja de
+ * transmitir su variable de estado queda en kMODULE_STATUS_DATA_PROBLEM.
+ *
+ * El estado de un módulo solo se recalcula si alguna de sus variables cambió de valor o de vencimiento.
  *
  */
 static void MONITORING_Update_ReceivedModulesStatus(void)
 {
-    bus_data.bms_status = MONITORING_API_Get_Bms_ReceivedStatus(&bus_data.Rx_Bms);                  // actualiza variable estado del módulo BMS
+    /** Máscara de variables vencidas en la pasada anterior */
+    static uint32_t last_stale_signals = 0;
+
+    uint32_t changed = DECODE_DATA_Take_UpdatedSignals(kDECODE_CONSUMER_MONITORING)
+                       | (bus_data.stale_signals ^ last_stale_signals);
 
-    bus_data.dcdc_status = MONITORING_API_Get_Dcdc_ReceivedStatus(&bus_data.Rx_Dcdc);               // actualiza variable estado del módulo DCDC
+    last_stale_signals = bus_data.stale_signals;
 
-    bus_data.inversor_status = MONITORING_API_Get_Inversor_ReceivedStatus(&bus_data.Rx_Inversor);   // actualiza variable estado del módulo inversor
+#if USE_VEHICLE_VAR_MONITORING_FEATURE == 1
+    /* MONITORING_Update_ModulesStatus sobrescribe el estado de los módulos en cada pasada */
+    changed = RX_SIGNAL_ALL_MASK;
+#endif /* USE_VEHICLE_VAR_MONITORING_FEATURE */
+
+    if (changed & RX_MODULE_SIGNALS_MASK(BMS))
+    {
+        bus_data.bms_status = MONITORING_API_Get_Bms_ReceivedStatus(&bus_data.Rx_Bms, bus_data.stale_signals);                  // actualiza variable estado del módulo BMS
+    }
+
+    if (changed & RX_MODULE_SIGNALS_MASK(DCDC))
+    {
+        bus_data.dcdc_status = MONITORING_API_Get_Dcdc_ReceivedStatus(&bus_data.Rx_Dcdc, bus_data.stale_signals);               // actualiza variable estado del módulo DCDC
+    }
+
+    if (changed & RX_MODULE_SIGNALS_MASK(INVERSOR))
+    {
+        bus_data.inversor_status = MONITORING_API_Get_Inversor_ReceivedStatus(&bus_data.Rx_Inversor, bus_data.stale_signals);   // actualiza variable estado del módulo inversor
+    }
 }
 
 #if USE_VEHICLE_VAR_MONITORING_FEATURE == 1
@@ -208,17 +233,20 @@ static void MONITORING_Update_AnalogVariablesState(void)
         /* Actualiza estado de las variables del módulo BMS */
         MONITORING_API_Bms_VariableMonitoring(  &bus_data.Rx_Bms,
                                                 &bus_data.St_Bms,
-                                                &bms_eco_limits);
+                                                &bms_eco_limits,
+                                                bus_data.stale_signals);
 
         /* Actualiza estado de las variables del módulo DCDC */
         MONITORING_API_Dcdc_VariableMonitoring( &bus_data.Rx_Dcdc,
                                                 &bus_data.St_Dcdc,
-                                                &dcdc_eco_limits);
+                                                &dcdc_eco_limits,
+                                                bus_data.stale_signals);
 
         /* Actualiza estado de las variables del módulo inversor */
         MONITORING_API_Inversor_VariableMonitoring( &bus_data.Rx_Inversor,
                                                     &bus_data.St_Inversor,
-                                                    &inversor_eco_limits);
+                                                    &inversor_eco_limits,
+                                                    bus_data.stale_signals);
 
         break;
 
@@ -227,17 +255,20 @@ static void MONITORING_Update_AnalogVariablesState(void)
         /* Actualiza estado de las variables del módulo BMS */
         MONITORING_API_Bms_VariableMonitoring(  &bus_data.Rx_Bms,
                                                 &bus_data.St_Bms,
-                                                &bms_normal_limits);
+                                                &bms_normal_limits,
+                                                bus_data.stale_signals);
 
         /* Actualiza estado de las variables del módulo DCDC */
         MONITORING_API_Dcdc_VariableMonitoring( &bus_data.Rx_Dcdc,
                                                 &bus_data.St_Dcdc,
-                                                &dcdc_normal_limits);
+                                                &dcdc_normal_limits,
+                                                bus_data.stale_signals);
 
         /* Actualiza estado de las variables del módulo inversor */
         MONITORING_API_Inversor_VariableMonitoring( &bus_data.Rx_Inversor,
                                                     &bus_data.St_Inversor,
-                                                    &inversor_normal_limits);
+                                                    &inversor_normal_limits,
+                                                    bus_data.stale_signals);
 
         break;
 
@@ -246,17 +277,20 @@ static void MONITORING_Update_AnalogVariablesState(void)
         /* Actualiza estado de las variables del módulo BMS */
         MONITORING_API_Bms_VariableMonitoring(  &bus_data.Rx_Bms,
                                                 &bus_data.St_Bms,
-                                                &bms_sport_limits);
+                                                &bms_sport_limits,
+                                                bus_data.stale_signals);
 
         /* Actualiza estado de las variables del módulo DCDC */
         MONITORING_API_Dcdc_VariableMonitoring( &bus_data.Rx_Dcdc,
                                                 &bus_data.St_Dcdc,
-                                                &dcdc_sport_limits);
+                                                &dcdc_sport_limits,
+                                                bus_data.stale_signals);
 
         /* Actualiza estado de las variables del módulo inversor */
         MONITORING_API_Inversor_VariableMonitoring( &bus_data.Rx_Inversor,
                                                     &bus_data.St_Inversor,
-                                                    &inversor_sport_limits);
+                                                    &inversor_sport_limits,
+                                                    bus_data.stale_signals);
 
         break;
 
@@ -25,10 +25,12 @@
  * @param Rx_Bms Puntero a estructura con variables decodificadas del BMS
  * @param St_Bms Puntero a estructura con estado de variables decodificadas del BMS
  * @param bms_limits Puntero a estructura con los límites de las variables del BMS
+ * @param stale_signals Máscara de variables del bus de entrada CAN vencidas (un bit por rx_signal_t)
  */
 void MONITORING_API_Bms_VariableMonitoring( rx_bms_vars_t* Rx_Bms,
                                             st_bms_vars_t* St_Bms,
-                                            const rx_bms_limits_t* bms_limits)
+                                            const rx_bms_limits_t* bms_limits,
+                                            uint32_t stale_signals)
 {
     /* NIVEL DE LA BATERÍA */
 
@@ -44,7 +46,7 @@ void MONITORING_API_Bms_VariableMonitoring( rx_bms_vars_t* Rx_Bms,
     {
         St_Bms->nivel_bateria = kVAR_STATE_PROBLEM;
     }
-	if(Rx_Bms->nivel_bateria == 0)
+	if(stale_signals & RX_SIGNAL_MASK(kRX_SIGNAL_BMS_NIVEL_BATERIA))
 	{
 		St_Bms->nivel_bateria = kVAR_STATE_DATA_PROBLEM;
 	}
@@ -59,7 +61,7 @@ void MONITORING_API_Bms_VariableMonitoring( rx_bms_vars_t* Rx_Bms,
     {
         St_Bms->voltaje = kVAR_STATE_PROBLEM;
     }
-	if(Rx_Bms->voltaje == 0)
+	if(stale_signals & RX_SIGNAL_MASK(kRX_SIGNAL_BMS_VOLTAJE))
 	{
 		St_Bms->voltaje = kVAR_STATE_DATA_PROBLEM;
 	}
@@ -79,7 +81,7 @@ void MONITORING_API_Bms_VariableMonitoring( rx_bms_vars_t* Rx_Bms,
     {
         St_Bms->potencia = kVAR_STATE_PROBLEM;
     }
-	if(Rx_Bms->potencia == 0)
+	if(stale_signals & RX_SIGNAL_MASK(kRX_SIGNAL_BMS_POTENCIA))
 	{
 		St_Bms->potencia = kVAR_STATE_DATA_PROBLEM;
 	}
@@ -91,10 +93,12 @@ void MONITORING_API_Bms_VariableMonitoring( rx_bms_vars_t* Rx_Bms,
  * @param Rx_Dcdc Puntero a estructura con variables decodificadas del DCDC
  * @param St_Dcdc Puntero a estructura con estado de variables decodificadas del DCDC
  * @param dcdc_limits Puntero a estructura con los límites de las variables del DCDC
+ * @param stale_signals Máscara de variables del bus de entrada CAN vencidas (un bit por rx_signal_t)
  */
 void MONITORING_API_Dcdc_VariableMonitoring(    rx_dcdc_vars_t* Rx_Dcdc,
                                                 st_dcdc_vars_t* St_Dcdc,
-                                                const rx_dcdc_limits_t* dcdc_limits)
+                                                const rx_dcdc_limits_t* dcdc_limits,
+                                                uint32_t stale_signals)
 {
     /* TEMPERATURA MÁXIMA DE MOSFETS */
     if( Rx_Dcdc->t_max < dcdc_limits->MAX_temp_max_mosfets &&
@@ -111,7 +115,7 @@ void MONITORING_API_Dcdc_VariableMonitoring(    rx_dcdc_vars_t* Rx_Dcdc,
     {
         St_Dcdc->t_max = kVAR_STATE_PROBLEM;
     }
-	if(Rx_Dcdc->t_max == 0)
+	if(stale_signals & RX_SIGNAL_MASK(kRX_SIGNAL_DCDC_T_MAX))
 	{
 		St_Dcdc->t_max = kVAR_STATE_DATA_PROBLEM;
 	}
@@ -126,7 +130,7 @@ void MONITORING_API_Dcdc_VariableMonitoring(    rx_dcdc_vars_t* Rx_Dcdc,
     {
         St_Dcdc->voltaje_salida = kVAR_STATE_PROBLEM;
     }
-	if(Rx_Dcdc->voltaje_salida == 0)
+	if(stale_signals & RX_SIGNAL_MASK(kRX_SIGNAL_DCDC_VOLTAJE_SALIDA))
 	{
 		St_Dcdc->voltaje_salida = kVAR_STATE_DATA_PROBLEM;
 	}
@@ -139,10 +143,12 @@ void MONITORING_API_Dcdc_VariableMonitoring(    rx_dcdc_vars_t* Rx_Dcdc,
  * @param Rx_Inversor Puntero a estructura con variables decodificadas del inversor
  * @param St_Inversor Puntero a estructura con estado de variables decodificadas del inversor
  * @param inversor_limits Puntero a estructura con los límites de las variables del inversor
+ * @param stale_signals Máscara de variables del bus de entrada CAN vencidas (un bit por rx_signal_t)
  */
 void MONITORING_API_Inversor_VariableMonitoring(    rx_inversor_vars_t* Rx_Inversor,
                                                     st_inversor_vars_t* St_Inversor,
-                                                    const rx_inversor_limits_t* inversor_limits)
+                                                    const rx_inversor_limits_t* inversor_limits,
+                                                    uint32_t stale_signals)
 {
     /* TEMPERATURA MÁXIMA DE MOSFETS */
     if( Rx_Inversor->temp_max < inversor_limits->MAX_temp_max_mosfets &&
@@ -159,7 +165,7 @@ void MONITORING_API_Inversor_VariableMonitoring(    rx_inversor_vars_t* Rx_Inver
     {
         St_Inversor->temp_max = kVAR_STATE_PROBLEM;
     }
-	if(Rx_Inversor->temp_max == 0)
+	if(stale_signals & RX_SIGNAL_MASK(kRX_SIGNAL_INVERSOR_TEMP_MAX))
 	{
 		St_Inversor->temp_max = kVAR_STATE_DATA_PROBLEM;
 	}
@@ -174,7 +180,7 @@ void MONITORING_API_Inversor_VariableMonitoring(    rx_inversor_vars_t* Rx_Inver
     {
         St_Inversor->V = kVAR_STATE_PROBLEM;
     }
-	if(Rx_Inversor->V == 0)
+	if(stale_signals & RX_SIGNAL_MASK(kRX_SIGNAL_INVERSOR_V))
 	{
 		St_Inversor->V = kVAR_STATE_DATA_PROBLEM;
 	}
@@ -186,11 +192,19 @@ void MONITORING_API_Inversor_VariableMonitoring(    rx_inversor_vars_t* Rx_Inver
 /**
  * @brief Retorna estado del módulo BMS de acuerdo al valor de la variable de estado de módulo recibida (bms_ok).
  *
+ * Si bms_ok dejó de recibirse (variable vencida), el estado es kMODULE_STATUS_DATA_PROBLEM.
+ *
  * @param Rx_Bms Puntero a estructura con variables decodificadas del BMS
+ * @param stale_signals Máscara de variables del bus de entrada CAN vencidas (un bit por rx_signal_t)
  * @return module_status_t
  */
-module_status_t MONITORING_API_Get_Bms_ReceivedStatus(rx_bms_vars_t* Rx_Bms)
+module_status_t MONITORING_API_Get_Bms_ReceivedStatus(rx_bms_vars_t* Rx_Bms, uint32_t stale_signals)
 {
+    if (stale_signals & RX_SIGNAL_MASK(kRX_SIGNAL_BMS_OK))   // el módulo dejó de transmitir su estado
+    {
+        return kMODULE_STATUS_DATA_PROBLEM;
+    }
+
     if (Rx_Bms->bms_ok == kMODULE_INFO_OK)       // verifica valor de la variable bms_ok
     {
         return kMODULE_STATUS_OK;                // retorna estado del módulo BMS
@@ -212,11 +226,19 @@ module_status_t MONITORING_API_Get_Bms_ReceivedStatus(rx_bms_vars_t* Rx_Bms)
 /**
  * @brief Retorna estado del módulo DCDC de acuerdo al valor de la variable de estado de módulo recibida (dcdc_ok).
  *
+ * Si dcdc_ok dejó de recibirse (variable vencida), el estado es kMODULE_STATUS_DATA_PROBLEM.
+ *
  * @param Rx_Dcdc Puntero a estructura con variables decodificadas del DCDC
+ * @param stale_signals Máscara de variables del bus de entrada CAN vencidas (un bit por rx_signal_t)
  * @return module_status_t
  */
-module_status_t MONITORING_API_Get_Dcdc_ReceivedStatus(rx_dcdc_vars_t* Rx_Dcdc)
+module_status_t MONITORING_API_Get_Dcdc_ReceivedStatus(rx_dcdc_vars_t* Rx_Dcdc, uint32_t stale_signals)
 {
+    if (stale_signals & RX_SIGNAL_MASK(kRX_SIGNAL_DCDC_OK))   // el módulo dejó de transmitir su estado
+    {
+        return kMODULE_STATUS_DATA_PROBLEM;
+    }
+
     if (Rx_Dcdc->dcdc_ok == kMODULE_INFO_OK)     // verifica valor de la variable dcdc_ok
     {
         return kMODULE_STATUS_OK;                // retorna estado del módulo DCDC
@@ -238,11 +260,19 @@ module_status_t MONITORING_API_Get_Dcdc_ReceivedStatus(rx_dcdc_vars_t* Rx_Dcdc)
 /**
  * @brief Retorna estado del módulo Inversor de acuerdo al valor de la variable de estado de módulo recibida (inversor_ok).
  *
+ * Si inversor_ok dejó de recibirse (variable vencida), el estado es kMODULE_STATUS_DATA_PROBLEM.
+ *
  * @param Rx_Inversor Puntero a estructura con variables decodificadas del inversor
+ * @param stale_signals Máscara de variables del bus de entrada CAN vencidas (un bit por rx_signal_t)
  * @return module_status_t
  */
-module_status_t MONITORING_API_Get_Inversor_ReceivedStatus(rx_inversor_vars_t* Rx_Inversor)
+module_status_t MONITORING_API_Get_Inversor_ReceivedStatus(rx_inversor_vars_t* Rx_Inversor, uint32_t stale_signals)
 {
+    if (stale_signals & RX_SIGNAL_MASK(kRX_SIGNAL_INVERSOR_OK))   // el módulo dejó de transmitir su estado
+    {
+        return kMODULE_STATUS_DATA_PROBLEM;
+    }
+
     if (Rx_Inversor->inversor_ok == kMODULE_INFO_OK)     // verifica valor de la variable inversor_ok
     {
         return kMODULE_STATUS_OK;                        // retorna estado del módulo inversor
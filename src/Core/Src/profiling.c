@@ -0,0 +1,70 @@
+/**
+ * @file profiling.c
+ * @author Subgrupo Control y Periféricos - Elektron Motorsports
+ * @brief Medición de tiempo de ejecución de tareas e interrupciones de tarjeta Control
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/***********************************************************************************************************************
+ * Included files
+ **********************************************************************************************************************/
+
+#include "profiling.h"
+
+/***********************************************************************************************************************
+ * Global variables definitions
+ **********************************************************************************************************************/
+
+#if PROFILING_ENABLED == 1
+/** @brief Tiempo de ejecución de cada punto de medición */
+profiling_stats_t profiling_stats[kPROFILE_COUNT];
+#endif /* PROFILING_ENABLED */
+
+/***********************************************************************************************************************
+ * Public functions implementation
+ **********************************************************************************************************************/
+
+/**
+ * @brief Inicialización del contador de ciclos DWT y de las estadísticas de ejecución.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param None
+ * @retval None
+ */
+void PROFILING_Init(void)
+{
+#if PROFILING_ENABLED == 1
+    for (uint32_t i = 0; i < kPROFILE_COUNT; i++)
+    {
+        profiling_stats[i].count = 0;
+        profiling_stats[i].min_cycles = UINT32_MAX;
+        profiling_stats[i].max_cycles = 0;
+        profiling_stats[i].sum_cycles = 0;
+    }
+
+    /* Habilita el bloque de trazas y el contador de ciclos */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif /* PROFILING_ENABLED */
+}
+
+/**
+ * @brief Tiempo de ejecución de un punto de medición.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param probe Punto de medición
+ * @return const profiling_stats_t* Tiempo de ejecución
+ */
+#if PROFILING_ENABLED == 1
+const profiling_stats_t *PROFILING_Get_Stats(profiling_probe_t probe)
+{
+    return &profiling_stats[probe];
+}
+#endif /* PROFILING_ENABLED */
@@ -0,0 +1,124 @@
+/**
+ * @file ram_monitor.c
+ * @author Subgrupo Control y Periféricos - Elektron Motorsports
+ * @brief Monitor de uso de stack y heap de tarjeta Control
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/***********************************************************************************************************************
+ * Included files
+ **********************************************************************************************************************/
+
+#include "ram_monitor.h"
+
+/***********************************************************************************************************************
+ * Private macros
+ **********************************************************************************************************************/
+
+/** @brief Palabras revisadas bajo la marca de agua en busca de stack usado */
+#define RAM_MONITOR_SCAN_WINDOW_WORDS   32U
+
+/** @brief Máximo de palabras revisadas por llamada a RAM_MONITOR_Process */
+#define RAM_MONITOR_SCAN_MAX_WORDS      512U
+
+/***********************************************************************************************************************
+ * Private variables definitions
+ **********************************************************************************************************************/
+
+/* Símbolos del linker script */
+extern uint32_t _end;
+extern uint32_t _estack;
+extern uint32_t _Min_Stack_Size;
+extern uint32_t _Min_Heap_Size;
+
+/* Máximo uso de heap, actualizado por _sbrk (sysmem.c) */
+extern uint32_t __sbrk_heap_peak;
+
+/** @brief Marca de agua: dirección más baja de stack usada conocida */
+static uint32_t *stack_low = &_estack;
+
+/** @brief Uso de stack y heap */
+static ram_monitor_stats_t ram_stats;
+
+/***********************************************************************************************************************
+ * Public functions implementation
+ **********************************************************************************************************************/
+
+/**
+ * @brief Función principal del monitor de RAM.
+ *
+ * El stack crece hacia abajo sobre RAM pintada con RAM_MONITOR_PAINT. Cada llamada revisa
+ * ventanas de RAM_MONITOR_SCAN_WINDOW_WORDS palabras bajo la marca de agua y la baja hasta la
+ * palabra usada más baja de la ventana, hasta encontrar una ventana sin usar o revisar
+ * RAM_MONITOR_SCAN_MAX_WORDS palabras. Como la marca de agua solo baja, la RAM sobre ella no se
+ * vuelve a revisar. Variables locales sin escribir de más de una ventana pueden ocultar uso de
+ * stack bajo ellas.
+ *
+ * La revisión no se detiene en _Min_Stack_Size, por lo que también mide un stack que excede lo
+ * reservado; se detiene en el heap usado.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param None
+ * @retval None
+ */
+void RAM_MONITOR_Process(void)
+{
+    uint32_t heap_peak = __sbrk_heap_peak;
+    uint32_t *heap_top = &_end + (heap_peak + 3U) / 4U;
+    uint32_t scanned = 0;
+    uint32_t *window_bottom;
+    uint32_t *used;
+
+    while (scanned < RAM_MONITOR_SCAN_MAX_WORDS)
+    {
+        window_bottom = stack_low - RAM_MONITOR_SCAN_WINDOW_WORDS;
+
+        if (window_bottom < heap_top)
+        {
+            window_bottom = heap_top;
+        }
+
+        used = NULL;
+
+        for (uint32_t *p = window_bottom; p < stack_low; p++)
+        {
+            if (*p != RAM_MONITOR_PAINT)
+            {
+                used = p;
+                break;
+            }
+        }
+
+        scanned += RAM_MONITOR_SCAN_WINDOW_WORDS;
+
+        if (used == NULL)
+        {
+            break;
+        }
+
+        stack_low = used;
+    }
+
+    ram_stats.stack_used_max = (uint32_t)((uint8_t *)&_estack - (uint8_t *)stack_low);
+    ram_stats.stack_size = (uint32_t)&_Min_Stack_Size;
+    ram_stats.heap_used_max = heap_peak;
+    ram_stats.heap_size = (uint32_t)&_Min_Heap_Size;
+}
+
+/**
+ * @brief Uso de stack y heap.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param None
+ * @return const ram_monitor_stats_t* Uso de stack y heap
+ */
+const ram_monitor_stats_t *RAM_MONITOR_Get_Stats(void)
+{
+    return &ram_stats;
+}
@@ -15,10 +15,68 @@
 
 #include "rampa_pedal.h"
 
+#include "scheduler.h"
+
 /***********************************************************************************************************************
  * Private macros
  **********************************************************************************************************************/
 
+/** @brief Variables del bus de recepción CAN de las que depende la rampa */
+#define RAMPA_PEDAL_SIGNALS     (RX_SIGNAL_MASK(kRX_SIGNAL_PERIFERICOS_PEDAL) | RX_SIGNAL_MASK(kRX_SIGNAL_PERIFERICOS_HOMBRE_MUERTO))
+
+/** @brief Entradas de la tabla de cada rampa: una por valor del byte de pedal */
+#define RAMPA_PEDAL_LUT_SIZE    256U
+
+/*
+ * Pendiente máxima de la velocidad enviada a inversor, por modo de manejo.
+ *
+ * X(mode, rise, fall)
+ *
+ *  mode    Modo de manejo (kDRIVING_MODE_<mode>)
+ *  rise    Subida máxima [nivel/s]
+ *  fall    Bajada máxima [nivel/s]
+ *
+ * Con modo de manejo desconocido se usan las pendientes de ECO.
+ */
+#define RAMPA_PEDAL_SLEW_RATES(X) \
+    X(ECO,      50,     200)    \
+    X(NORMAL,   100,    300)    \
+    X(SPORT,    250,    500)
+
+/** @brief Nivel en punto fijo del limitador */
+#define RAMPA_PEDAL_SLEW_FIXED(level)   ((uint32_t)(level) << RAMPA_PEDAL_SLEW_FRAC_BITS)
+
+/** @brief Desplazamiento entre el punto fijo del limitador y el nivel de velocidad en CAN */
+#define RAMPA_PEDAL_SLEW_SHIFT          (RAMPA_PEDAL_SLEW_FRAC_BITS - CAN_PEDAL_FRAC_BITS)
+
+/** @brief Pendiente [nivel/s] a paso por periodo, en punto fijo, redondeado */
+#define RAMPA_PEDAL_SLEW_STEP(rate) \
+    ((RAMPA_PEDAL_SLEW_FIXED(rate) * RAMPA_PEDAL_PERIOD_MS + 500U) / 1000U)
+
+/**
+ * @brief Periodos máximos que avanza el limitador en una pasada (2 s): con cualquier pendiente
+ * recorre la escala completa, y el paso acumulado no desborda
+ */
+#define RAMPA_PEDAL_SLEW_MAX_PERIODS    (2000U / RAMPA_PEDAL_PERIOD_MS)
+
+/***********************************************************************************************************************
+ * Private types declarations
+ **********************************************************************************************************************/
+
+/**
+ * @brief Tipo de dato rampa_pedal_calibration_t para buffer de calibración de la rampa.
+ *
+ * Mapa de pedal y sus tablas expandidas, para que ambos se activen juntos con el puntero.
+ *
+ */
+typedef struct
+{
+	rampa_pedal_map_t	map;												/**< Mapa de pedal cargado */
+#if CAN_HIGH_RES_PEDAL == 0
+	uint8_t				lut[RAMPA_PEDAL_NUM_OF_MODES][RAMPA_PEDAL_LUT_SIZE];	/**< Nivel de velocidad por valor de pedal, por modo */
+#endif /* CAN_HIGH_RES_PEDAL */
+} rampa_pedal_calibration_t;
+
 /***********************************************************************************************************************
  * Private variables definitions
  **********************************************************************************************************************/
@@ -26,19 +84,89 @@
 /** Puntero a estructura de tipo rx_peripherals_vars_t que contiene los valores de las variables decodificadas de periféricos */
 static rx_peripherals_vars_t* Rx_Peripherals = &bus_data.Rx_Peripherals;
 
+/** @brief Modo de manejo de la última actualización de la rampa */
+static driving_mode_t rampa_last_driving_mode;
+
+/**
+ * @brief Mapa de pedal por defecto.
+ *
+ * Los puntos coinciden con los extremos de los tramos rectos de la rampa original, por lo
+ * que la interpolación reproduce sus valores.
+ */
+static const rampa_pedal_map_t rampa_pedal_default_map =
+{
+	.points =
+	{
+		/*							0%	20%	40%	60%	80%	100% */
+		[kDRIVING_MODE_ECO]		= {	0,	5,	15,	30,	60,	100 },
+		[kDRIVING_MODE_NORMAL]	= {	0,	10,	30,	70,	90,	100 },
+		[kDRIVING_MODE_SPORT]	= {	0,	30,	55,	75,	90,	100 },
+	}
+};
+
+/** @brief Buffers de calibración: uno activo, usado por la rampa, y otro donde se carga el siguiente mapa */
+static rampa_pedal_calibration_t rampa_pedal_calibration[2];
+
+/** @brief Buffer de calibración activo. Se cambia con una sola escritura (atómica) */
+static const rampa_pedal_calibration_t *volatile rampa_pedal_active;
+
+/** @brief Buffer de calibración usado en la última actualización de la rampa */
+static const rampa_pedal_calibration_t *rampa_last_calibration;
+
+/**
+ * @brief Se activó un mapa que la rampa aún no leyó. Mientras esté activo no se acepta otra
+ * carga, porque el buffer inactivo puede seguir en uso por la pasada en curso.
+ */
+static volatile bool rampa_pedal_swap_pending;
+
+#if CAN_HIGH_RES_PEDAL == 0
+_Static_assert(sizeof(((typedef_bus3_t *)0)->pedal) == 1, "Las tablas de rampa pedal se indexan con el byte de pedal");
+#endif /* CAN_HIGH_RES_PEDAL */
+
+#define RAMPA_PEDAL_SLEW_RISE(mode, rise, fall) \
+    [kDRIVING_MODE_##mode] = RAMPA_PEDAL_SLEW_STEP(rise),
+
+#define RAMPA_PEDAL_SLEW_FALL(mode, rise, fall) \
+    [kDRIVING_MODE_##mode] = RAMPA_PEDAL_SLEW_STEP(fall),
+
+/*
+ * Pendientes en RAM (no const, fuera de flash): las lee RAMPA_PEDAL_Slew_Step, que se
+ * ejecuta desde SRAM
+ */
+
+/** @brief Subida máxima por periodo de cada modo de manejo [nivel, punto fijo] */
+static uint32_t rampa_pedal_slew_rise[RAMPA_PEDAL_NUM_OF_MODES] =
+{
+    RAMPA_PEDAL_SLEW_RATES(RAMPA_PEDAL_SLEW_RISE)
+};
+
+/** @brief Bajada máxima por periodo de cada modo de manejo [nivel, punto fijo] */
+static uint32_t rampa_pedal_slew_fall[RAMPA_PEDAL_NUM_OF_MODES] =
+{
+    RAMPA_PEDAL_SLEW_RATES(RAMPA_PEDAL_SLEW_FALL)
+};
+
+#undef RAMPA_PEDAL_SLEW_RISE
+#undef RAMPA_PEDAL_SLEW_FALL
+
+/** @brief Estado del limitador de pendiente */
+static rampa_pedal_slew_t rampa_pedal_slew;
+
+/** @brief Tick [ms] de la liberación de la pasada anterior de la rampa */
+static uint32_t rampa_last_release_ms;
+
+/** @brief Hubo una pasada anterior de la rampa (rampa_last_release_ms es válido) */
+static bool rampa_release_valid;
+
 /***********************************************************************************************************************
  * Private functions prototypes
  **********************************************************************************************************************/
 
-static float RAMPA_PEDAL_Get_Rampa_Eco(rx_var_t pedal);
+static uint16_t RAMPA_PEDAL_Interpolate(const uint8_t *points, uint32_t pedal);
 
-static float RAMPA_PEDAL_Get_Rampa_Normal(rx_var_t pedal);
+static void RAMPA_PEDAL_Slew_Step(driving_mode_t mode, uint32_t periods);
 
-static float RAMPA_PEDAL_Get_Rampa_Sport(rx_var_t pedal);
-
-static float RAMPA_PEDAL_Get_Rampa_HombreMuerto(rx_var_t pedal);
-
-static void RAMPA_PEDAL_Send_Velocidad(float to_send, typedef_bus2_t* bus_can_output);
+static void RAMPA_PEDAL_Send_Velocidad(uint16_t to_send, typedef_bus2_t* bus_can_output);
 
 static void RAMPA_PEDAL_Send_HM_State(hm_state_t to_send, typedef_bus2_t* bus_can_output);
 
@@ -46,183 +174,307 @@ static void RAMPA_PEDAL_Send_HM_State(hm_state_t to_send, typedef_bus2_t* bus_ca
  * Public functions implementation
  **********************************************************************************************************************/
 
+/**
+ * @brief Inicialización de la rampa pedal.
+ *
+ * Carga el mapa de pedal por defecto.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param   None
+ * @retval  None
+ */
+void RAMPA_PEDAL_Init(void)
+{
+    rampa_pedal_swap_pending = false;
+
+    (void)RAMPA_PEDAL_Load_Map(&rampa_pedal_default_map);
+}
+
+/**
+ * @brief Carga un mapa de pedal nuevo.
+ *
+ * El mapa se copia y se expande a tablas en el buffer de calibración inactivo, y se activa
+ * con una sola escritura del puntero de mapa activo: RAMPA_PEDAL_Process usa siempre un mapa
+ * completo. Puede ser llamada desde interrupciones.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param   map     Puntero al mapa a cargar
+ * @retval  true si se cargó; false si algún nivel es mayor a RAMPA_PEDAL_MAP_MAX_LEVEL o la
+ *          rampa aún no usó el mapa de la carga anterior
+ */
+bool RAMPA_PEDAL_Load_Map(const rampa_pedal_map_t *map)
+{
+    rampa_pedal_calibration_t *next;
+    uint32_t primask;
+    uint32_t mode;
+    uint32_t i;
+
+    for (mode = 0; mode < RAMPA_PEDAL_NUM_OF_MODES; mode++)
+    {
+        for (i = 0; i < RAMPA_PEDAL_MAP_POINTS; i++)
+        {
+            if (map->points[mode][i] > RAMPA_PEDAL_MAP_MAX_LEVEL)
+            {
+                return false;
+            }
+        }
+    }
+
+    /* Reserva el buffer inactivo; una carga desde interrupción no puede tomar el mismo */
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (rampa_pedal_swap_pending)
+    {
+        __set_PRIMASK(primask);
+        return false;
+    }
+
+    rampa_pedal_swap_pending = true;
+    next = (rampa_pedal_active == &rampa_pedal_calibration[0]) ? &rampa_pedal_calibration[1] : &rampa_pedal_calibration[0];
+
+    __set_PRIMASK(primask);
+
+    next->map = *map;
+
+#if CAN_HIGH_RES_PEDAL == 0
+    for (mode = 0; mode < RAMPA_PEDAL_NUM_OF_MODES; mode++)
+    {
+        for (i = 0; i < RAMPA_PEDAL_LUT_SIZE; i++)
+        {
+            next->lut[mode][i] = (uint8_t)RAMPA_PEDAL_Interpolate(next->map.points[mode], i);
+        }
+    }
+#endif /* CAN_HIGH_RES_PEDAL */
+
+    /* El buffer queda completo antes de publicarlo */
+    __DMB();
+    rampa_pedal_active = next;
+
+    return true;
+}
+
 /**
  * @brief Función principal de bloque rampa pedal.
  *
  * Se encarga de transformar el valor de pedal registrado de periféricos a un valor de
  * velocidad que será empleado por inversor. Para cada modo de manejo se tiene una
  * función de transferencia diferente para determinar el valor de velocidad asociado al
- * valor de pedal registrado desde periféricos.
+ * valor de pedal registrado desde periféricos, precalculada en una tabla por modo a partir
+ * del mapa de pedal activo.
+ *
+ * El nivel objetivo solo se recalcula si cambió el pedal, el hombre muerto, el modo de manejo
+ * o el mapa activo. La velocidad enviada a inversor sigue al objetivo con la pendiente máxima
+ * del modo de manejo, avanzando un paso por cada RAMPA_PEDAL_PERIOD_MS transcurrido desde la
+ * pasada anterior, incluidas las liberaciones que el scheduler perdió.
  *
  * No es static, por lo que puede ser usada por otros archivos.
  *
  * @param   None
  * @retval  None
  */
-void RAMPA_PEDAL_Process(void)
+RAMFUNC void RAMPA_PEDAL_Process(void)
 {
-    if (Rx_Peripherals->hombre_muerto == kHOMBRE_MUERTO_ON)
+    uint32_t updated = DECODE_DATA_Take_UpdatedSignals(kDECODE_CONSUMER_RAMPA_PEDAL);
+    uint32_t release_ms = SCHEDULER_Get_ReleaseMs();
+    const rampa_pedal_calibration_t *calibration;
+    uint32_t periods = 1U;
+    uint16_t nivel;
+
+    /* Periodos desde la pasada anterior: el scheduler ejecuta una sola vez las liberaciones perdidas */
+    if (rampa_release_valid)
     {
-        /* Actualiza velocidad inversor en bus de datos */
-        bus_data.velocidad_inversor = RAMPA_PEDAL_Get_Rampa_HombreMuerto(Rx_Peripherals->pedal);
+        periods = (release_ms - rampa_last_release_ms) / RAMPA_PEDAL_PERIOD_MS;
+
+        if (periods > RAMPA_PEDAL_SLEW_MAX_PERIODS)
+        {
+            periods = RAMPA_PEDAL_SLEW_MAX_PERIODS;
+        }
     }
-    else if (Rx_Peripherals->hombre_muerto == kHOMBRE_MUERTO_OFF)
+
+    rampa_last_release_ms = release_ms;
+    rampa_release_valid = true;
+
+    /*
+     * Libera la carga de mapas antes de leer el puntero: una carga posterior escribe en el
+     * buffer que no se está leyendo, y otra más espera a la siguiente pasada
+     */
+    rampa_pedal_swap_pending = false;
+    __DMB();
+    calibration = rampa_pedal_active;
+
+    if ((updated & RAMPA_PEDAL_SIGNALS) != 0U || bus_data.driving_mode != rampa_last_driving_mode
+            || calibration != rampa_last_calibration)
     {
-        switch (bus_data.driving_mode)
+        rampa_last_driving_mode = bus_data.driving_mode;
+        rampa_last_calibration = calibration;
+
+        /* En un estado de hombre muerto o modo de manejo desconocido se mantiene el objetivo anterior */
+        nivel = rampa_pedal_slew.target;
+
+        if (Rx_Peripherals->hombre_muerto == kHOMBRE_MUERTO_ON)
         {
-        case kDRIVING_MODE_ECO:
-            /* Actualiza velocidad inversor en bus de datos */
-            bus_data.velocidad_inversor = RAMPA_PEDAL_Get_Rampa_Eco(Rx_Peripherals->pedal);
-            break;
-        
-        case kDRIVING_MODE_NORMAL:
-            /* Actualiza velocidad inversor en bus de datos */
-            bus_data.velocidad_inversor = RAMPA_PEDAL_Get_Rampa_Normal(Rx_Peripherals->pedal);
-            break;
-        
-        case kDRIVING_MODE_SPORT:
-            /* Actualiza velocidad inversor en bus de datos */
-            bus_data.velocidad_inversor = RAMPA_PEDAL_Get_Rampa_Sport(Rx_Peripherals->pedal);
-            break;
-        
-        default:
-            break;
+            /* Hombre muerto presionado: velocidad 0 */
+            nivel = 0;
         }
+        else if (Rx_Peripherals->hombre_muerto == kHOMBRE_MUERTO_OFF && bus_data.driving_mode < RAMPA_PEDAL_NUM_OF_MODES
+                && calibration != NULL)
+        {
+#if CAN_HIGH_RES_PEDAL == 1
+            /* Pedal de alta resolución: interpolación directa del mapa, en el punto fijo de CAN */
+            nivel = RAMPA_PEDAL_Interpolate(calibration->map.points[bus_data.driving_mode], bus_can_input.pedal);
+#else
+            /*
+             * Tabla del modo de manejo, indexada con el byte de pedal recibido (el pedal decodificado
+             * tiene escala 1 y offset 0 en can_def.h)
+             */
+            nivel = calibration->lut[bus_data.driving_mode][bus_can_input.pedal];
+#endif /* CAN_HIGH_RES_PEDAL */
+        }
+
+        rampa_pedal_slew.target = nivel;
+
+        /* Actualiza estado hombre muerto a bus de salida CAN */
+        RAMPA_PEDAL_Send_HM_State(Rx_Peripherals->hombre_muerto, &bus_can_output);
     }
 
-    /* Actualiza velocidad inversor en bus de salida CAN */
-    RAMPA_PEDAL_Send_Velocidad(bus_data.velocidad_inversor, &bus_can_output);
+    /* Un paso del limitador por periodo transcurrido, aunque el objetivo no haya cambiado */
+    RAMPA_PEDAL_Slew_Step(bus_data.driving_mode, periods);
+}
 
-	/* Actualiza estado hombre muerto a bus de salida CAN */
-	RAMPA_PEDAL_Send_HM_State(Rx_Peripherals->hombre_muerto, &bus_can_output);
+/**
+ * @brief Estado del limitador de pendiente.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param None
+ * @return const rampa_pedal_slew_t* Estado del limitador
+ */
+const rampa_pedal_slew_t *RAMPA_PEDAL_Get_Slew(void)
+{
+    return &rampa_pedal_slew;
 }
 
 /***********************************************************************************************************************
  * Private functions implementation
  **********************************************************************************************************************/
 
-
 /**
- * @brief Rampa pedal para modo ECO
+ * @brief Nivel de velocidad de un mapa para un valor de pedal.
  *
- * @param pedal     Pedal de periféricos
- * @return float  Velocidad [0:100]
+ * Interpolación lineal en grilla uniforme: el tramo se obtiene dividiendo por la separación
+ * entre puntos, sin búsqueda, por lo que el tiempo es constante. En el último punto (pedal
+ * 100) se usa su nivel; un pedal mayor está fuera de rango y da nivel 0, como la rampa
+ * original. Pedal y nivel están en el punto fijo de CAN (CAN_PEDAL_FRAC_BITS); el
+ * nivel se redondea al más cercano. La separación es constante, por lo que las divisiones
+ * se compilan como multiplicaciones.
+ *
+ * @param points    Niveles de los puntos de la grilla de un modo de manejo
+ * @param pedal     Valor de pedal
+ * @retval Nivel de velocidad [0:100], en el punto fijo de CAN
  */
-static float RAMPA_PEDAL_Get_Rampa_Eco(rx_var_t pedal) {
-
-    float velocidad = 0;
+static RAMFUNC uint16_t RAMPA_PEDAL_Interpolate(const uint8_t *points, uint32_t pedal)
+{
+    const uint32_t step = RAMPA_PEDAL_MAP_STEP << CAN_PEDAL_FRAC_BITS;
+    const uint32_t last = (RAMPA_PEDAL_MAP_POINTS - 1U) * step;
+    uint32_t index = pedal / step;
+    int32_t frac;
+    int32_t scaled;
 
-    if (pedal >= 0 && pedal < 20)
-    {
-        velocidad = pedal * 0.25;
-    }
-    else if (pedal >= 20 && pedal < 40)
-    {
-        velocidad = (0.5 * pedal) - 5;
-    }
-    else if (pedal >= 40 && pedal < 60)
+    if (pedal > last)
     {
-        velocidad = (0.75 * pedal) - 15;
+        return 0U;
     }
-    else if (pedal >= 60 && pedal < 80)
-    {
-        velocidad = (1.5 * pedal) - 60;
-    }
-    else if (pedal >= 80 && pedal < 100)
+
+    if (pedal == last)
     {
-        velocidad = (2 * pedal) - 100;
+        return (uint16_t)((uint32_t)points[RAMPA_PEDAL_MAP_POINTS - 1U] << CAN_PEDAL_FRAC_BITS);
     }
 
-    return velocidad;
+    frac = (int32_t)(pedal - (index * step));
+
+    /* Nivel multiplicado por la separación; no es negativo porque queda entre dos niveles */
+    scaled = ((int32_t)((uint32_t)points[index] << CAN_PEDAL_FRAC_BITS) * (int32_t)step)
+            + ((((int32_t)points[index + 1U] - (int32_t)points[index]) * (int32_t)(1UL << CAN_PEDAL_FRAC_BITS)) * frac);
+
+    return (uint16_t)(((uint32_t)scaled + (step / 2U)) / step);
 }
 
 /**
- * @brief Rampa pedal para modo NORMAL
+ * @brief Paso del limitador de pendiente.
  *
- * @param pedal     Pedal de periféricos
- * @return float  Velocidad [0:100]
+ * Avanza la salida hacia el nivel objetivo, como máximo la pendiente de subida o de bajada
+ * del modo de manejo por cada periodo transcurrido, y envía el nivel redondeado si cambió.
+ * Solo multiplica, suma, compara y desplaza enteros, por lo que su tiempo es constante.
+ *
+ * @param mode Modo de manejo actual
+ * @param periods Periodos de RAMPA_PEDAL_PERIOD_MS desde el paso anterior
+ * @retval None
  */
-static float RAMPA_PEDAL_Get_Rampa_Normal(rx_var_t pedal) {
-
-    float velocidad = 0;
+static RAMFUNC void RAMPA_PEDAL_Slew_Step(driving_mode_t mode, uint32_t periods)
+{
+    uint32_t target = (uint32_t)rampa_pedal_slew.target << RAMPA_PEDAL_SLEW_SHIFT;
+    uint32_t output = rampa_pedal_slew.output;
+    uint32_t rise;
+    uint32_t fall;
+    uint16_t level;
 
-    if (pedal >= 0 && pedal < 20)
-    {
-        velocidad = pedal * 0.5;
-    }
-    else if (pedal >= 20 && pedal < 40)
-    {
-        velocidad = pedal - 10;
-    }
-    else if (pedal >= 40 && pedal < 60)
-    {
-        velocidad = (2 * pedal) - 50;
-    }
-    else if (pedal >= 60 && pedal < 80)
+    if (mode >= RAMPA_PEDAL_NUM_OF_MODES)
     {
-        velocidad = pedal + 10;
-    }
-    else if (pedal >= 80 && pedal < 100)
-    {
-        velocidad = (0.5 * pedal) + 50;
+        mode = kDRIVING_MODE_ECO;
     }
 
-    return velocidad;
-}
+    rise = rampa_pedal_slew_rise[mode] * periods;
+    fall = rampa_pedal_slew_fall[mode] * periods;
 
-/**
- * @brief Rampa pedal para modo SPORT
- *
- * @param pedal     Pedal de periféricos
- * @return float  Velocidad [0:100]
- */
-static float RAMPA_PEDAL_Get_Rampa_Sport(rx_var_t pedal) {
-
-    float velocidad = 0;
+    rampa_pedal_slew.rising = (target > output) && ((target - output) > rise);
+    rampa_pedal_slew.falling = (output > target) && ((output - target) > fall);
 
-    if (pedal >= 0 && pedal < 20)
+    if (rampa_pedal_slew.rising)
     {
-        velocidad = pedal * 1.5;
+        output += rise;
     }
-    else if (pedal >= 20 && pedal < 40)
+    else if (rampa_pedal_slew.falling)
     {
-        velocidad = (1.25 * pedal) + 5;
+        output -= fall;
     }
-    else if (pedal >= 40 && pedal < 60)
+    else
     {
-        velocidad = (1 * pedal) + 15;
+        output = target;
     }
-    else if (pedal >= 60 && pedal < 80)
+
+    if (rampa_pedal_slew.rising || rampa_pedal_slew.falling)
     {
-        velocidad = (0.75 * pedal) + 30;
+        rampa_pedal_slew.limited_periods++;
     }
-    else if (pedal >= 80 && pedal < 100)
+
+    rampa_pedal_slew.output = output;
+
+    level = (uint16_t)((output + (1UL << (RAMPA_PEDAL_SLEW_SHIFT - 1U))) >> RAMPA_PEDAL_SLEW_SHIFT);
+
+    if (level != rampa_pedal_slew.level)
     {
-        velocidad = (0.5 * pedal) + 50;
-    }
+        rampa_pedal_slew.level = level;
 
-    return velocidad;
-}
+        /* Actualiza velocidad inversor en bus de datos */
+        bus_data.velocidad_inversor = (float)level * CAN_PEDAL_SCALE;
 
-/**
- * @brief Rampa pedal en caso de hombre muerto presionado.
- *
- * @param pedal     Pedal de periféricos
- * @return float  Velocidad [0:100]
- */
-static float RAMPA_PEDAL_Get_Rampa_HombreMuerto(rx_var_t pedal) {
-    return 0.0;
+        /* Actualiza velocidad inversor en bus de salida CAN */
+        RAMPA_PEDAL_Send_Velocidad(level, &bus_can_output);
+    }
 }
 
 /**
- * @brief Envío de velocidad a bus de datos y a bus de salida CAN.
+ * @brief Envío de velocidad a bus de salida CAN.
  *
- * @param to_send           Velocidad a enviar
+ * @param to_send           Nivel de velocidad a enviar, en el punto fijo de CAN
  * @param bus_can_output    Puntero a estructura de tipo typedef_bus2_t (bus de salida CAN)
  */
-static void RAMPA_PEDAL_Send_Velocidad(float to_send, typedef_bus2_t* bus_can_output)
+static RAMFUNC void RAMPA_PEDAL_Send_Velocidad(uint16_t to_send, typedef_bus2_t* bus_can_output)
 {
-    bus_can_output->nivel_velocidad = (uint8_t)round(to_send);
+    bus_can_output->nivel_velocidad = (CAN_PEDAL_TYPE)to_send;
 }
 
 /**
@@ -231,7 +483,7 @@ static void RAMPA_PEDAL_Send_Velocidad(float to_send, typedef_bus2_t* bus_can_ou
  * @param to_send           Estado de hombre muerto a enviar
  * @param bus_can_output    Puntero a estructura de tipo typedef_bus2_t (bus de salida CAN)
  */
-static void RAMPA_PEDAL_Send_HM_State(hm_state_t to_send, typedef_bus2_t* bus_can_output)
+static RAMFUNC void RAMPA_PEDAL_Send_HM_State(hm_state_t to_send, typedef_bus2_t* bus_can_output)
 {
     /* Envío a bus de salida CAN */
     switch (to_send)
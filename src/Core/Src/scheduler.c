@@ -0,0 +1,363 @@
+/**
+ * @file scheduler.c
+ * @author Subgrupo Control y Periféricos - Elektron Motorsports
+ * @brief Scheduler cooperativo de tareas de tarjeta Control
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/***********************************************************************************************************************
+ * Included files
+ **********************************************************************************************************************/
+
+#include "scheduler.h"
+#include "profiling.h"
+#include "timebase.h"
+
+#include "can_app.h"
+#include "decode_data.h"
+#include "monitoring.h"
+#include "failures.h"
+#include "driving_modes.h"
+#include "rampa_pedal.h"
+#include "indicators.h"
+#include "ram_monitor.h"
+
+/***********************************************************************************************************************
+ * Private types declarations
+ **********************************************************************************************************************/
+
+/**
+ * @brief Entrada de la tabla de tareas del scheduler
+ *
+ */
+typedef struct
+{
+    void        (*function)(void);  /**< Función de la tarea */
+    uint16_t    period_ms;          /**< Periodo de liberación */
+    uint16_t    offset_ms;          /**< Desfase de la primera liberación */
+    uint32_t    deadline_us;        /**< Plazo desde la liberación */
+    uint32_t    budget_us;          /**< Tiempo de ejecución máximo esperado */
+} scheduler_task_t;
+
+/***********************************************************************************************************************
+ * Private variables definitions
+ **********************************************************************************************************************/
+
+#define SCHEDULER_TASK_ENTRY(name, function, period_ms, offset_ms, deadline_us, budget_us) \
+    [kTASK_##name] = {function, period_ms, offset_ms, deadline_us, budget_us},
+
+/** @brief Tabla de tareas del scheduler */
+static const scheduler_task_t scheduler_tasks[kTASK_COUNT] =
+{
+    SCHEDULER_TASKS(SCHEDULER_TASK_ENTRY)
+};
+
+#undef SCHEDULER_TASK_ENTRY
+
+/** @brief Tick [ms] de la siguiente liberación de cada tarea */
+static uint32_t scheduler_release_ms[kTASK_COUNT];
+
+/** @brief Estadísticas de ejecución de cada tarea */
+static scheduler_task_stats_t scheduler_stats[kTASK_COUNT];
+
+/** @brief Tick [ms] de la liberación atendida por la tarea en ejecución */
+static uint32_t scheduler_current_release_ms;
+
+/** @brief Scheduler inicializado (hay tareas periódicas) */
+static bool scheduler_started = false;
+
+/** @brief Carga de CPU */
+static scheduler_cpu_stats_t scheduler_cpu_stats;
+
+/** @brief Inicio [us] de la ventana actual de medición de carga */
+static uint32_t load_window_start_us;
+
+/** @brief Tiempo [us] dormido en la ventana actual */
+static uint32_t load_window_idle_us;
+
+/** @brief Salidas de WFI en la ventana actual */
+static uint32_t load_window_wakeups;
+
+/***********************************************************************************************************************
+ * Private functions prototypes
+ **********************************************************************************************************************/
+
+static void SCHEDULER_Run_Task(scheduler_task_id_t task, uint32_t release_ms);
+static bool SCHEDULER_Is_Pending(void);
+static void SCHEDULER_Update_Load(void);
+
+/***********************************************************************************************************************
+ * Public functions implementation
+ **********************************************************************************************************************/
+
+/**
+ * @brief Inicialización del scheduler cooperativo.
+ *
+ * La primera liberación de cada tarea es offset_ms después de la inicialización.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param None
+ * @retval None
+ */
+void SCHEDULER_Init(void)
+{
+    uint32_t now_ms = HAL_GetTick();
+
+    for (uint32_t i = 0; i < kTASK_COUNT; i++)
+    {
+        scheduler_release_ms[i] = now_ms + scheduler_tasks[i].offset_ms;
+    }
+
+    scheduler_started = true;
+}
+
+/**
+ * @brief Función principal del scheduler cooperativo.
+ *
+ * Ejecuta, en orden de la tabla de tareas, cada tarea liberada desde la última pasada. Si una
+ * tarea perdió liberaciones (pasada anterior demasiado larga), se ejecuta una sola vez y las
+ * liberaciones perdidas se cuentan como overrun.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param None
+ * @retval None
+ */
+void SCHEDULER_Process(void)
+{
+    for (uint32_t i = 0; i < kTASK_COUNT; i++)
+    {
+        uint32_t now_ms = HAL_GetTick();
+        uint32_t release_ms = scheduler_release_ms[i];
+        uint32_t period_ms = scheduler_tasks[i].period_ms;
+        uint32_t missed;
+
+        if ((int32_t)(now_ms - release_ms) < 0)
+        {
+            continue;
+        }
+
+        missed = (now_ms - release_ms) / period_ms;
+
+        scheduler_stats[i].overruns += missed;
+        scheduler_release_ms[i] = release_ms + (missed + 1U) * period_ms;
+
+        SCHEDULER_Run_Task((scheduler_task_id_t)i, release_ms + missed * period_ms);
+    }
+}
+
+/**
+ * @brief Espera de la siguiente interrupción, si no hay tareas liberadas.
+ *
+ * Se llama al final de cada pasada del loop principal. Revisa con interrupciones deshabilitadas
+ * si hay tareas liberadas y, si no, duerme con WFI: una interrupción que llega entre la revisión
+ * y WFI queda pendiente y despierta al núcleo de inmediato, por lo que no se pierde. Las
+ * interrupciones pendientes se atienden al rehabilitarlas. SysTick despierta al núcleo al menos
+ * cada 1 ms.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param None
+ * @retval None
+ */
+void SCHEDULER_Idle(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    uint32_t sleep_us;
+
+    __disable_irq();
+
+    if (!SCHEDULER_Is_Pending())
+    {
+        sleep_us = TIMEBASE_Get_TimeUs();
+
+        __DSB();
+        __WFI();
+
+        load_window_idle_us += TIMEBASE_Get_TimeUs() - sleep_us;
+        load_window_wakeups++;
+    }
+
+    __set_PRIMASK(primask);
+
+    SCHEDULER_Update_Load();
+}
+
+/**
+ * @brief Estadísticas de ejecución de una tarea.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param task Tarea
+ * @return const scheduler_task_stats_t* Estadísticas de la tarea
+ */
+const scheduler_task_stats_t *SCHEDULER_Get_TaskStats(scheduler_task_id_t task)
+{
+    return &scheduler_stats[task];
+}
+
+/**
+ * @brief Tick de la liberación atendida por la tarea en ejecución.
+ *
+ * Si la tarea perdió liberaciones es la última de ellas, por lo que la diferencia con la
+ * liberación de la ejecución anterior incluye los periodos perdidos. Se ejecuta desde SRAM
+ * porque la llama el camino de control (RAMPA_PEDAL_Process).
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param None
+ * @return uint32_t Tick [ms] de la liberación
+ */
+RAMFUNC uint32_t SCHEDULER_Get_ReleaseMs(void)
+{
+    return scheduler_current_release_ms;
+}
+
+/**
+ * @brief Carga de CPU.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param None
+ * @return const scheduler_cpu_stats_t* Carga de CPU
+ */
+const scheduler_cpu_stats_t *SCHEDULER_Get_CpuStats(void)
+{
+    return &scheduler_cpu_stats;
+}
+
+/***********************************************************************************************************************
+ * Private functions implementation
+ **********************************************************************************************************************/
+
+/**
+ * @brief Revisa si hay tareas liberadas sin ejecutar.
+ *
+ * Antes de SCHEDULER_Init no hay tareas periódicas; el loop principal solo atiende eventos
+ * de interrupciones.
+ *
+ * @param None
+ * @retval true     Hay tareas liberadas
+ * @retval false    No hay tareas liberadas
+ */
+static bool SCHEDULER_Is_Pending(void)
+{
+    uint32_t now_ms = HAL_GetTick();
+
+    if (!scheduler_started)
+    {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < kTASK_COUNT; i++)
+    {
+        if ((int32_t)(now_ms - scheduler_release_ms[i]) >= 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Cierra la ventana de medición de carga de CPU, si terminó.
+ *
+ * @param None
+ * @retval None
+ */
+static void SCHEDULER_Update_Load(void)
+{
+    uint32_t now_us = TIMEBASE_Get_TimeUs();
+    uint32_t window_us = now_us - load_window_start_us;
+    uint32_t idle_us = load_window_idle_us;
+    uint32_t load_permille;
+
+    if (window_us < SCHEDULER_LOAD_WINDOW_MS * 1000U)
+    {
+        return;
+    }
+
+    if (idle_us > window_us)
+    {
+        idle_us = window_us;
+    }
+
+    load_permille = 1000U - (uint32_t)(((uint64_t)idle_us * 1000U) / window_us);
+
+    scheduler_cpu_stats.load_permille = load_permille;
+    scheduler_cpu_stats.wakeups = load_window_wakeups;
+    scheduler_cpu_stats.idle_sum_us += idle_us;
+
+    if (load_permille > scheduler_cpu_stats.load_max_permille)
+    {
+        scheduler_cpu_stats.load_max_permille = load_permille;
+    }
+
+    load_window_start_us = now_us;
+    load_window_idle_us = 0;
+    load_window_wakeups = 0;
+}
+
+/**
+ * @brief Ejecuta una tarea y actualiza sus estadísticas.
+ *
+ * @param task Tarea
+ * @param release_ms Tick [ms] de la liberación atendida
+ * @retval None
+ */
+static void SCHEDULER_Run_Task(scheduler_task_id_t task, uint32_t release_ms)
+{
+    const scheduler_task_t *entry = &scheduler_tasks[task];
+    scheduler_task_stats_t *stats = &scheduler_stats[task];
+    uint32_t release_us = release_ms * 1000U;
+    uint32_t start_us = TIMEBASE_Get_TimeUs();
+    uint32_t end_us;
+    uint32_t exec_us;
+    uint32_t latency_us;
+
+    scheduler_current_release_ms = release_ms;
+
+    {
+        PROFILING_START();
+
+        entry->function();
+
+        PROFILING_STOP(PROFILING_TASK(task));
+    }
+
+    end_us = TIMEBASE_Get_TimeUs();
+    exec_us = end_us - start_us;
+
+    /* La liberación es el inicio del tick, por lo que la latencia nunca es negativa */
+    latency_us = start_us - release_us;
+
+    stats->runs++;
+    stats->exec_last_us = exec_us;
+    stats->exec_sum_us += exec_us;
+
+    if (exec_us > stats->exec_max_us)
+    {
+        stats->exec_max_us = exec_us;
+    }
+
+    if (latency_us > stats->latency_max_us)
+    {
+        stats->latency_max_us = latency_us;
+    }
+
+    if (exec_us > entry->budget_us)
+    {
+        stats->budget_overruns++;
+    }
+
+    if ((end_us - release_us) > entry->deadline_us)
+    {
+        stats->deadline_misses++;
+    }
+}
@@ -22,6 +22,8 @@
 #include "stm32f4xx_it.h"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "profiling.h"
+#include "can_hw.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -47,6 +49,11 @@
 /* Private function prototypes -----------------------------------------------*/
 /* USER CODE BEGIN PFP */
 
+/* Interrupciones CAN ejecutadas desde SRAM (RAMFUNC), siguen atendiendo durante escrituras a flash */
+RAMFUNC void CAN1_TX_IRQHandler(void);
+RAMFUNC void CAN1_RX0_IRQHandler(void);
+RAMFUNC void CAN1_RX1_IRQHandler(void);
+
 /* USER CODE END PFP */
 
 /* Private user code ---------------------------------------------------------*/
@@ -199,31 +206,94 @@ void SysTick_Handler(void)
 /* please refer to the startup file (startup_stm32f4xx.s).                    */
 /******************************************************************************/
 
+/**
+  * @brief This function handles CAN1 TX interrupts.
+  */
+void CAN1_TX_IRQHandler(void)
+{
+  /* USER CODE BEGIN CAN1_TX_IRQn 0 */
+  PROFILING_START();
+
+  /* HAL_CAN_IRQHandler (flash) solo atiende transmisiones fallidas o abortadas */
+  if (!CAN_HW_Service_TxMailboxes())
+  {
+    PROFILING_STOP(kPROFILE_ISR_CAN1_TX);
+    return;
+  }
+  /* USER CODE END CAN1_TX_IRQn 0 */
+  HAL_CAN_IRQHandler(&hcan1);
+  /* USER CODE BEGIN CAN1_TX_IRQn 1 */
+  PROFILING_STOP(kPROFILE_ISR_CAN1_TX);
+  /* USER CODE END CAN1_TX_IRQn 1 */
+}
+
 /**
   * @brief This function handles CAN1 RX0 interrupt.
   */
 void CAN1_RX0_IRQHandler(void)
 {
   /* USER CODE BEGIN CAN1_RX0_IRQn 0 */
+  PROFILING_START();
 
+  /* HAL_CAN_IRQHandler (flash) solo atiende el overrun */
+  if (!CAN_HW_Service_RxFifo(RX_FIFO_0))
+  {
+    PROFILING_STOP(kPROFILE_ISR_CAN1_RX0);
+    return;
+  }
   /* USER CODE END CAN1_RX0_IRQn 0 */
   HAL_CAN_IRQHandler(&hcan1);
   /* USER CODE BEGIN CAN1_RX0_IRQn 1 */
-
+  PROFILING_STOP(kPROFILE_ISR_CAN1_RX0);
   /* USER CODE END CAN1_RX0_IRQn 1 */
 }
 
+/**
+  * @brief This function handles CAN1 RX1 interrupt.
+  */
+void CAN1_RX1_IRQHandler(void)
+{
+  /* USER CODE BEGIN CAN1_RX1_IRQn 0 */
+  PROFILING_START();
+
+  /* HAL_CAN_IRQHandler (flash) solo atiende el overrun */
+  if (!CAN_HW_Service_RxFifo(RX_FIFO_1))
+  {
+    PROFILING_STOP(kPROFILE_ISR_CAN1_RX1);
+    return;
+  }
+  /* USER CODE END CAN1_RX1_IRQn 0 */
+  HAL_CAN_IRQHandler(&hcan1);
+  /* USER CODE BEGIN CAN1_RX1_IRQn 1 */
+  PROFILING_STOP(kPROFILE_ISR_CAN1_RX1);
+  /* USER CODE END CAN1_RX1_IRQn 1 */
+}
+
+/**
+  * @brief This function handles CAN1 SCE interrupt.
+  */
+void CAN1_SCE_IRQHandler(void)
+{
+  /* USER CODE BEGIN CAN1_SCE_IRQn 0 */
+  PROFILING_START();
+  /* USER CODE END CAN1_SCE_IRQn 0 */
+  HAL_CAN_IRQHandler(&hcan1);
+  /* USER CODE BEGIN CAN1_SCE_IRQn 1 */
+  PROFILING_STOP(kPROFILE_ISR_CAN1_SCE);
+  /* USER CODE END CAN1_SCE_IRQn 1 */
+}
+
 /**
   * @brief This function handles TIM7 global interrupt.
   */
 void TIM7_IRQHandler(void)
 {
   /* USER CODE BEGIN TIM7_IRQn 0 */
-
+  PROFILING_START();
   /* USER CODE END TIM7_IRQn 0 */
   HAL_TIM_IRQHandler(&htim7);
   /* USER CODE BEGIN TIM7_IRQn 1 */
-
+  PROFILING_STOP(kPROFILE_ISR_TIM7);
   /* USER CODE END TIM7_IRQn 1 */
 }
 
@@ -22,6 +22,9 @@
 
 /* USER CODE BEGIN 0 */
 
+/** @brief Frecuencia de conteo de TIM7 [Hz]: periodo de 100 cuentas = 10 ms */
+#define TIM7_COUNTER_HZ             10000U
+
 /* USER CODE END 0 */
 
 TIM_HandleTypeDef htim7;
@@ -38,11 +41,12 @@ void MX_TIM7_Init(void)
 
   /* USER CODE BEGIN TIM7_Init 1 */
 
+
   /* USER CODE END TIM7_Init 1 */
   htim7.Instance = TIM7;
   htim7.Init.Prescaler = 8000-1;
   htim7.Init.CounterMode = TIM_COUNTERMODE_UP;
-  htim7.Init.Period = 10000-1;
+  htim7.Init.Period = 100-1;
   htim7.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
   if (HAL_TIM_Base_Init(&htim7) != HAL_OK)
   {
@@ -56,6 +60,21 @@ void MX_TIM7_Init(void)
   }
   /* USER CODE BEGIN TIM7_Init 2 */
 
+  /* APB1 timer clock of the selected clock profile (CLOCK_PROFILE): x2 if APB1 is divided.
+     Control.ioc describes the low-power profile; any other profile re-initializes the
+     prescaler here so that CubeMX regeneration keeps it */
+  uint32_t tim7_clock_hz = HAL_RCC_GetPCLK1Freq() * (((RCC->CFGR & RCC_CFGR_PPRE1_2) != 0U) ? 2U : 1U);
+  uint32_t tim7_prescaler = tim7_clock_hz / TIM7_COUNTER_HZ - 1U;
+
+  if (htim7.Init.Prescaler != tim7_prescaler)
+  {
+    htim7.Init.Prescaler = tim7_prescaler;
+    if (HAL_TIM_Base_Init(&htim7) != HAL_OK)
+    {
+      Error_Handler();
+    }
+  }
+
   /* USER CODE END TIM7_Init 2 */
 
 }
@@ -0,0 +1,53 @@
+/**
+ * @file timebase.c
+ * @author Subgrupo Control y Periféricos - Elektron Motorsports
+ * @brief Base de tiempo en microsegundos, común a los drivers y a la aplicación
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/***********************************************************************************************************************
+ * Included files
+ **********************************************************************************************************************/
+
+#include "timebase.h"
+
+/***********************************************************************************************************************
+ * Public functions implementation
+ **********************************************************************************************************************/
+
+/**
+ * @brief Tiempo [us] desde el inicio, con base en SysTick.
+ *
+ * Desborda cada ~71 minutos; las diferencias se calculan con aritmética sin signo.
+ * Puede ser llamada desde interrupciones. Se ejecuta desde SRAM y lee uwTick directamente
+ * (en lugar de HAL_GetTick) porque la usan las interrupciones CAN.
+ *
+ * No es static, por lo que puede ser usada por otros archivos.
+ *
+ * @param None
+ * @return uint32_t Tiempo [us]
+ */
+RAMFUNC uint32_t TIMEBASE_Get_TimeUs(void)
+{
+    uint32_t load = SysTick->LOAD + 1U;
+    uint32_t ms;
+    uint32_t val;
+
+    do
+    {
+        ms = uwTick;
+        val = SysTick->VAL;
+    } while (ms != uwTick);
+
+    /* SysTick desbordó pero su interrupción (menor prioridad) aún no incrementa el tick */
+    if ((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) && (val > load / 2U))
+    {
+        ms++;
+    }
+
+    return ms * 1000U + ((load - 1U - val) * 1000U) / load;
+}
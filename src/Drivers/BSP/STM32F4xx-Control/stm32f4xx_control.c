@@ -43,9 +43,12 @@ int32_t BSP_BUZZER_Init(void)
 	TIM_MasterConfigTypeDef sMasterConfig = {0};
 	TIM_OC_InitTypeDef sConfigOC = {0};
 
-	/* Configure the Buzzer PWM Timer */
+	/* APB2 timer clock: x2 if APB2 is divided */
+	uint32_t tim_clock_hz = HAL_RCC_GetPCLK2Freq() * (((RCC->CFGR & RCC_CFGR_PPRE2_2) != 0U) ? 2U : 1U);
+
+	/* Configure the Buzzer PWM Timer (1 MHz counter, 4 kHz tone for any system clock) */
 	htim_buzzer.Instance = BUZZER_PWM_TIM_INSTANCE;
-	htim_buzzer.Init.Prescaler = 80-1;
+	htim_buzzer.Init.Prescaler = tim_clock_hz / BUZZER_PWM_COUNTER_HZ - 1;
 	htim_buzzer.Init.CounterMode = TIM_COUNTERMODE_UP;
 	htim_buzzer.Init.Period = 250-1;
 	htim_buzzer.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
@@ -85,6 +88,9 @@ int32_t BSP_BUZZER_Init(void)
 
 	HAL_GPIO_Init(BUZZER_GPIO_PORT, &GPIO_InitStruct);
 
+	/* Start PWM with 0% duty cycle (silent), so BSP_BUZZER_Write only updates the duty cycle */
+	HAL_TIM_PWM_Start(&htim_buzzer, BUZZER_PWM_TIM_CHANNEL);
+
 	return BSP_ERROR_NONE;
 }
 
@@ -118,7 +124,7 @@ int32_t BSP_BUZZER_DeInit(void)
 int32_t BSP_BUZZER_On(void)
 {
 	/* Configure Duty Cycle */
-	BUZZER_PWM_TIM_INSTANCE->CCR3=125;
+	BUZZER_PWM_TIM_INSTANCE->CCR3=BUZZER_PWM_PULSE;
 
 	/* Start PWM */
 	HAL_TIM_PWM_Start(&htim_buzzer, BUZZER_PWM_TIM_CHANNEL);
@@ -140,6 +146,23 @@ int32_t BSP_BUZZER_Off(void)
     return BSP_ERROR_NONE;
 }
 
+/**
+ * @brief Turns Buzzer On or Off through its duty cycle, with a single register write.
+ *
+ * PWM is started by BSP_BUZZER_Init and must not be stopped (BSP_BUZZER_Off) while
+ * using this function. Can be called from interrupts.
+ *
+ * @param State: 0 to turn Buzzer Off, any other value to turn it On.
+ * @return BSP Status
+ */
+int32_t BSP_BUZZER_Write(uint32_t State)
+{
+	/* Configure Duty Cycle */
+	BUZZER_PWM_TIM_INSTANCE->CCR3 = (State != 0U) ? BUZZER_PWM_PULSE : 0U;
+
+    return BSP_ERROR_NONE;
+}
+
 /**
  * @brief Configures LED GPIO.
  *
@@ -260,3 +283,32 @@ int32_t BSP_LED_GetState(Led_TypeDef Led)
     return BSP_ERROR_NONE;
 }
 
+/**
+ * @brief Sets the state of all LEDs with a single BSRR write.
+ *
+ * @param LedMask: LEDs to be set on (LED_MASK(LED1), LED_MASK(LED2), LED_MASK(LED3));
+ *        the rest are set off. Can be called from interrupts.
+ * @return BSP Status
+ */
+int32_t BSP_LED_Write(uint32_t LedMask)
+{
+    uint32_t on_pins = 0;
+    uint32_t off_pins = 0;
+
+    for (uint32_t led = 0; led < LEDn; led++)
+    {
+        if (LedMask & LED_MASK(led))
+        {
+            on_pins |= LED_PIN[led];
+        }
+        else
+        {
+            off_pins |= LED_PIN[led];
+        }
+    }
+
+    /* LEDs are active low: reset (upper half) turns on, set (lower half) turns off */
+    LEDS_GPIO_PORT->BSRR = (on_pins << 16U) | off_pins;
+
+    return BSP_ERROR_NONE;
+}
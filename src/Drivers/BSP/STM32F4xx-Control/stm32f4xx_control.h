@@ -58,6 +58,12 @@
 
 #define LEDx_GPIO_CLK_ENABLE(__INDEX__)         __HAL_RCC_GPIOE_CLK_ENABLE()
 #define LEDx_GPIO_CLK_DISABLE(__INDEX__)        __HAL_RCC_GPIOE_CLK_DISABLE()
+
+/* All LEDs share one port, so BSP_LED_Write updates them with a single BSRR write */
+#define LEDS_GPIO_PORT                          GPIOE
+
+#define LED_MASK(__LED__)                       (1UL << (__LED__))
+#define LED_ALL_MASK                            (LED_MASK(LED1) | LED_MASK(LED2) | LED_MASK(LED3))
 /**
   * @}
   */
@@ -73,6 +79,8 @@
 #define BUZZER_GPIO_CLK_DISABLE()               __HAL_RCC_GPIOA_CLK_DISABLE()
 #define BUZZER_TIM_CLK_ENABLE()				    __HAL_RCC_TIM1_CLK_ENABLE()
 #define BUZZER_TIM_CLK_DISABLE()			    __HAL_RCC_TIM1_CLK_DISABLE()
+#define BUZZER_PWM_PULSE                        125U
+#define BUZZER_PWM_COUNTER_HZ                   1000000U
 /**
   * @}
   */
@@ -114,6 +122,8 @@ int32_t    BSP_LED_Toggle(Led_TypeDef Led);
 
 int32_t    BSP_LED_GetState(Led_TypeDef Led);
 
+int32_t    BSP_LED_Write(uint32_t LedMask);
+
 /**
   * @}
   */
@@ -130,6 +140,8 @@ int32_t    BSP_BUZZER_On(void);
 
 int32_t    BSP_BUZZER_Off(void);
 
+int32_t    BSP_BUZZER_Write(uint32_t State);
+
 /**
   * @}
   */
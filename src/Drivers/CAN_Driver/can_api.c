@@ -35,17 +35,13 @@
  * @param RTR Type of frame
  * @param Fn_Init_Can CAN initialization driver function
  * @param Fn_Send_Can_Data CAN send data driver function
- * @param Fn_Read_Can_Data CAN read data driver function
- * @param Fn_Get_Msg_Count CAN get message driver function
  * @return can_status_t
  */
 can_status_t CAN_API_Init(  CAN_t *obj,
                         	can_id_t IDE,
 							can_rtr_t RTR,
 							init_ll_can_t Fn_Init_Can,
-							send_can_data_t Fn_Send_Can_Data,
-							read_can_data_t Fn_Read_Can_Data,
-							get_msg_count_t Fn_Get_Msg_Count)
+							send_can_data_t Fn_Send_Can_Data)
 {
     can_status_t status;
 
@@ -53,10 +49,6 @@ can_status_t CAN_API_Init(  CAN_t *obj,
 
     obj->Fn_Send_Can_Data = Fn_Send_Can_Data;
 
-    obj->Fn_Read_Can_Data = Fn_Read_Can_Data;
-
-    obj->Fn_Get_Msg_Count = Fn_Get_Msg_Count;
-
     obj->Frame.IDE = IDE;
     obj->Frame.RTR = RTR;
     obj->Frame.payload_length = 0;
@@ -88,38 +80,3 @@ can_status_t CAN_API_Send_Message( CAN_t *obj)
 
     return status;
 }
-
-/**
- * @brief CAN read message function.
- *
- * No es static, por lo que puede ser usada por otros archivos.
- *
- * @param obj CAN structure instance
- * @return can_status_t
- */
-can_status_t CAN_API_Read_Message( CAN_t *obj)
-{
-    can_status_t status;
-
-    status = obj->Fn_Read_Can_Data( &obj->Frame.id,
-                                    obj->Frame.payload_buff);
-
-    return status;
-}
-
-/**
- * @brief CAN get message count function.
- *
- * No es static, por lo que puede ser usada por otros archivos.
- *
- * @param obj CAN structure instance
- * @return can_status_t
- */
-can_status_t CAN_API_Get_Message_Count( CAN_t *obj)
-{
-    can_status_t status;
-
-    status = obj->Fn_Get_Msg_Count();
-
-    return status;
-}
@@ -50,6 +50,16 @@ typedef enum
     RTR_MSG
 } can_rtr_t;
 
+/**
+ * @brief CAN receive FIFO type declaration
+ *
+ */
+typedef enum
+{
+    RX_FIFO_0 = 0,
+    RX_FIFO_1
+} can_rx_fifo_t;
+
 /**
   * @brief CAN Status type declaration
   *
@@ -78,6 +88,8 @@ typedef struct
 
     uint8_t payload_length;     /**< Length of payload in bytes */
 
+    uint32_t timestamp_us;      /**< Reception time [us], taken when the frame is read from the hardware FIFO */
+
 } can_frame_t;
 
 /**
@@ -92,18 +104,6 @@ typedef can_status_t (*init_ll_can_t)(void);
  */
 typedef can_status_t (*send_can_data_t)(uint32_t, uint8_t, uint8_t, uint8_t, uint8_t *);
 
-/**
- * @brief CAN read data driver function type declaration
- *
- */
-typedef can_status_t (*read_can_data_t)(uint32_t *, uint8_t *);
-
-/**
- * @brief CAN get message count driver function type declaration
- *
- */
-typedef can_status_t (*get_msg_count_t)(void);
-
 /**
  * @brief CAN structure declaration
  *
@@ -116,10 +116,6 @@ typedef struct
 
     send_can_data_t Fn_Send_Can_Data;   /**< CAN send data driver function */
 
-    read_can_data_t Fn_Read_Can_Data;   /**< CAN read data driver function */
-
-    get_msg_count_t Fn_Get_Msg_Count;   /**< CAN get message count driver function */
-
 } CAN_t;
 
 /***********************************************************************************************************************
@@ -136,17 +132,13 @@ typedef struct
  * @param RTR Type of frame
  * @param Fn_Init_Can CAN initialization driver function
  * @param Fn_Send_Can_Data CAN send data driver function
- * @param Fn_Read_Can_Data CAN read data driver function
- * @param Fn_Get_Msg_Count CAN get message driver function
  * @return can_status_t
  */
 can_status_t CAN_API_Init(  CAN_t *obj,
                         	can_id_t IDE,
 							can_rtr_t RTR,
 							init_ll_can_t Fn_Init_Can,
-							send_can_data_t Fn_Send_Can_Data,
-							read_can_data_t Fn_Read_Can_Data,
-							get_msg_count_t Fn_Get_Msg_Count);
+							send_can_data_t Fn_Send_Can_Data);
 
 /**
  * @brief CAN send message function.
@@ -158,26 +150,6 @@ can_status_t CAN_API_Init(  CAN_t *obj,
  */
 can_status_t CAN_API_Send_Message( CAN_t *obj);
 
-/**
- * @brief CAN read message function.
- *
- * No es static, por lo que puede ser usada por otros archivos.
- *
- * @param obj
- * @return can_status_t
- */
-can_status_t CAN_API_Read_Message( CAN_t *obj);
-
-/**
- * @brief CAN get message count function.
- *
- * No es static, por lo que puede ser usada por otros archivos.
- *
- * @param obj
- * @return can_status_t
- */
-can_status_t CAN_API_Get_Message_Count( CAN_t *obj);
-
 /***********************************************************************************************************************
  * Global variables declarations
  **********************************************************************************************************************/
@@ -15,6 +15,20 @@
 
 #include "can_wrapper.h"
 
+/***********************************************************************************************************************
+ * Private types declarations
+ **********************************************************************************************************************/
+
+/**
+ * @brief Aligned block of consecutive standard identifiers accepted by a single filter
+ *
+ */
+typedef struct
+{
+	uint32_t id;		/**< First identifier of the block (multiple of size) */
+	uint32_t size;		/**< Number of identifiers of the block (power of 2) */
+} can_filter_block_t;
+
 /***********************************************************************************************************************
  * Private variables definitions
  **********************************************************************************************************************/
@@ -22,18 +36,80 @@
 /* STM32 CAN Tx message header structure instance */
 static CAN_TxHeaderTypeDef TxHeader;
 
-/* STM32 CAN Rx message header structure definition */
-static CAN_RxHeaderTypeDef RxHeader;
-
 /* STM32 CAN filter configuration structure instance */
 static CAN_FilterTypeDef sFilterConfig;
 
+/* Selects the identifiers of received signals assigned to a given FIFO */
+#define CAN_FILTER_FIFO_0_0(...)    __VA_ARGS__
+#define CAN_FILTER_FIFO_0_1(...)
+#define CAN_FILTER_FIFO_1_0(...)
+#define CAN_FILTER_FIFO_1_1(...)    __VA_ARGS__
+
+/* Legacy identifiers are only accepted for modules in legacy frame mode */
+#define CAN_FILTER_FIFO0_ID(module, id_name, id, dir, fifo, field, type, decode, dest, scale, offset, period_ms) \
+    CAN_SIGNAL_IF_LEGACY(module, CAN_SIGNAL_IF_RX(dir, CAN_FILTER_FIFO_0_##fifo(CAN_ID_##id_name,)))
+
+#define CAN_FILTER_FIFO1_ID(module, id_name, id, dir, fifo, field, type, decode, dest, scale, offset, period_ms) \
+    CAN_SIGNAL_IF_LEGACY(module, CAN_SIGNAL_IF_RX(dir, CAN_FILTER_FIFO_1_##fifo(CAN_ID_##id_name,)))
+
+/* Packed frame identifiers are only accepted for modules in packed frame mode */
+#define CAN_FILTER_FIFO0_PACKED_ID(module, id_name, id, dir, fifo, first_id_name, first_field) \
+    CAN_SIGNAL_IF_PACKED(module, CAN_SIGNAL_IF_RX(dir, CAN_FILTER_FIFO_0_##fifo(CAN_ID_##id_name,)))
+
+#define CAN_FILTER_FIFO1_PACKED_ID(module, id_name, id, dir, fifo, first_id_name, first_field) \
+    CAN_SIGNAL_IF_PACKED(module, CAN_SIGNAL_IF_RX(dir, CAN_FILTER_FIFO_1_##fifo(CAN_ID_##id_name,)))
+
+/* Standard identifiers routed to FIFO0 (telemetry), generated from the CAN signal registry */
+static const uint32_t fifo0_ids[] = {CAN_SIGNALS(CAN_FILTER_FIFO0_ID) CAN_PACKED_FRAMES(CAN_FILTER_FIFO0_PACKED_ID)};
+
+/* Standard identifiers routed to FIFO1 (latency-critical messages), generated from the CAN signal registry */
+static const uint32_t fifo1_ids[] = {CAN_SIGNALS(CAN_FILTER_FIFO1_ID) CAN_PACKED_FRAMES(CAN_FILTER_FIFO1_PACKED_ID)};
+
+/* Number of filter banks of a single CAN instance */
+#define CAN_FILTER_NUM_OF_BANKS_MAX     14
+
+/* Number of identifiers per filter bank in 16-bit ID list mode */
+#define CAN_FILTER_IDS_PER_BANK         4
+
+/* Number of identifier/mask pairs per filter bank in 16-bit ID mask mode */
+#define CAN_FILTER_MASKS_PER_BANK       2
+
+/* Maximum number of identifiers routed to a FIFO */
+#define CAN_FILTER_MAX_IDS              (CAN_FILTER_NUM_OF_BANKS_MAX * CAN_FILTER_IDS_PER_BANK)
+
+/* Number of identifiers of an identifiers array */
+#define CAN_FILTER_NUM_OF_IDS(ids)      (sizeof(ids)/sizeof(ids[0]))
+
+/* Number of filter banks needed for an identifiers array in the worst case (16-bit ID list mode only) */
+#define CAN_FILTER_NUM_OF_BANKS(ids)    ((CAN_FILTER_NUM_OF_IDS(ids) + CAN_FILTER_IDS_PER_BANK - 1) / CAN_FILTER_IDS_PER_BANK)
+
+/* 16-bit filter mapping of a standard identifier: STID[10:0] in bits 15:5, RTR in bit 4, IDE in bit 3 */
+#define CAN_FILTER_16BIT_ID(id)         ((uint32_t)(id) << 5)
+
+/* 16-bit filter mask of an aligned block of identifiers: compares the block STID bits, RTR and IDE */
+#define CAN_FILTER_16BIT_MASK(size)     ((((~((uint32_t)(size) - 1U)) & 0x7FFU) << 5) | 0x18U)
+
+_Static_assert(CAN_FILTER_NUM_OF_BANKS(fifo0_ids) + CAN_FILTER_NUM_OF_BANKS(fifo1_ids) <= CAN_FILTER_NUM_OF_BANKS_MAX,
+               "Received CAN signals do not fit in the 14 filter banks");
+
+/* Sorted identifiers of the FIFO being planned */
+static uint32_t plan_ids[CAN_FILTER_MAX_IDS];
+
+/* Identifier blocks of the FIFO being planned */
+static can_filter_block_t plan_blocks[CAN_FILTER_MAX_IDS];
+
 /***********************************************************************************************************************
  * Private functions prototypes
  **********************************************************************************************************************/
 
 static void CAN_FilterConfig(void);
 
+static uint32_t CAN_FilterConfig_Fifo(const uint32_t *ids, uint32_t num_of_ids, uint32_t fifo, uint32_t first_bank);
+
+static uint32_t CAN_FilterPlan_Blocks(const uint32_t *ids, uint32_t num_of_ids, can_filter_block_t *blocks);
+
+static uint32_t CAN_FilterConfig_Bank(uint32_t bank, uint32_t fifo, uint32_t mode, const uint32_t *regs, uint32_t num_of_regs);
+
 /***********************************************************************************************************************
  * Public functions implementation
  **********************************************************************************************************************/
@@ -70,8 +146,12 @@ can_status_t CAN_Wrapper_Init(void)
 		Error_Handler();
 	}
 
-	/* Activate CAN notification (enable interrupts) */
-	if (HAL_CAN_ActivateNotification(&hcan1, CAN_IT_RX_FIFO0_MSG_PENDING) != HAL_OK)
+	/* Activate CAN notification (enable interrupts): transmit mailbox empty, reception, FIFO overrun and error status change */
+	if (HAL_CAN_ActivateNotification(&hcan1, CAN_IT_TX_MAILBOX_EMPTY |
+											 CAN_IT_RX_FIFO0_MSG_PENDING | CAN_IT_RX_FIFO1_MSG_PENDING |
+											 CAN_IT_RX_FIFO0_OVERRUN | CAN_IT_RX_FIFO1_OVERRUN |
+											 CAN_IT_ERROR_WARNING | CAN_IT_ERROR_PASSIVE | CAN_IT_BUSOFF |
+											 CAN_IT_LAST_ERROR_CODE | CAN_IT_ERROR) != HAL_OK)
 	{
 		Error_Handler();
 	}
@@ -92,7 +172,7 @@ can_status_t CAN_Wrapper_Init(void)
  * @param rtr Type of frame
  * @param dlc Length of frame
  * @param data Data to transmit
- * @retval None
+ * @retval can_status_t CAN_STATUS_ERROR if the message could not be loaded in a transmit mailbox
  */
 can_status_t CAN_Wrapper_TransmitData(uint32_t id, uint8_t ide, uint8_t rtr, uint8_t dlc, uint8_t *data)
 {
@@ -109,51 +189,15 @@ can_status_t CAN_Wrapper_TransmitData(uint32_t id, uint8_t ide, uint8_t rtr, uin
 	TxHeader.RTR = CAN_RTR_DATA;    			// type of frame
 	TxHeader.TransmitGlobalTime = DISABLE;
 
-	/* Start CAN transmission process */
+	/* Start CAN transmission process (fails with no free mailbox or while CAN is stopped for bus-off recovery) */
 	if (HAL_CAN_AddTxMessage(&hcan1, &TxHeader, data, &TxMailbox) != HAL_OK)
 	{
-		Error_Handler();
+		return CAN_STATUS_ERROR;
 	}
 
 	return CAN_STATUS_OK;
 }
 
-/**
- * @brief Función wrapper recepción de datos CAN.
- *
- * No es static, por lo que puede ser usada por otros archivos.
- *
- * @param id Received identifier
- * @param data Received data
- * @retval  None
- */
-can_status_t CAN_Wrapper_ReceiveData(uint32_t *id, uint8_t *data)
-{
-	/*
-	 *  STM32 CAN receive message
-	 */
-
-	/* Get CAN received message */
-    HAL_CAN_GetRxMessage(&hcan1, CAN_RX_FIFO0, &RxHeader, data);
-
-    /* Received standard identifier */
-    *id = RxHeader.StdId;
-
-	return CAN_STATUS_OK;
-}
-
-/**
- * @brief Función wrapper conteo dato recibido por CAN.
- *
- * No es static, por lo que puede ser usada por otros archivos.
- *
- * @return can_status_t
- */
-can_status_t CAN_Wrapper_DataCount(void)
-{
-	return CAN_STATUS_OK;
-}
-
 /***********************************************************************************************************************
  * Private functions implementation
  **********************************************************************************************************************/
@@ -174,73 +218,250 @@ static void CAN_FilterConfig(void)
 	 * For single CAN instance the are 14 dedicated filter banks.
 	 * The FilterBank parameter must be a number between 0 and 13.
 	 *
-	 * In Mask mode the identifier registers are associated with
-	 * mask registers specifying which bits of the identifier are
-	 * handled as "must watch" or as "don't care".
+	 * CAN standard format: 11-bit identifier. All banks use 16-bit scale, where
+	 * a standard identifier is mapped as STID[10:0] << 5, so each bank holds either
+	 * four exact identifiers (ID list mode) or two identifier/mask pairs (ID mask mode).
 	 *
-	 * One 32-bit filter register per filter bank in Identifier Mask mode.
-	 * One 32-bit mask register per filter bank in Identifier Mask mode.
-	 *
-	 * CAN standard format: 11-bit identifier.
-	 *
-	 * 5-bit shifting for standard identifier mapping.
+	 * Every received signal of the CAN signal registry is accepted exactly, in FIFO1
+	 * for latency-critical identifiers and FIFO0 for the rest. No other identifier,
+	 * remote frame or extended frame is accepted, so only wanted frames raise an
+	 * interrupt. FIFO0 and FIFO1 identifiers are disjoint, so filter match priority
+	 * does not change the assigned FIFO.
 	 */
 
-	/* CAN filter configuration shared among all configured filter banks */
-	sFilterConfig.FilterActivation = CAN_FILTER_ENABLE;
-	sFilterConfig.FilterFIFOAssignment = CAN_FILTER_FIFO0;
-	sFilterConfig.FilterMode = CAN_FILTERMODE_IDMASK;
-	sFilterConfig.FilterScale = CAN_FILTERSCALE_32BIT;
+	uint32_t bank;
 
-	/* CAN filter configuration structure for Filter Bank 1 */
-	sFilterConfig.FilterBank = 1;
-	sFilterConfig.FilterIdHigh = 0x00 << 5;
-	sFilterConfig.FilterIdLow = 0x0000;
-	sFilterConfig.FilterMaskIdHigh = (0xFFFF << 3) << 5;
-	sFilterConfig.FilterMaskIdLow = 0x0000;
+	bank = CAN_FilterConfig_Fifo(fifo1_ids, CAN_FILTER_NUM_OF_IDS(fifo1_ids), CAN_FILTER_FIFO1, 0);
 
-	/* Configure CAN filter */
-	if (HAL_CAN_ConfigFilter(&hcan1, &sFilterConfig)!= HAL_OK)
+	CAN_FilterConfig_Fifo(fifo0_ids, CAN_FILTER_NUM_OF_IDS(fifo0_ids), CAN_FILTER_FIFO0, bank);
+}
+
+/**
+ * @brief CAN filter configuration function for a FIFO
+ *
+ * Plans and configures the cheapest set of consecutive filter banks that accepts exactly
+ * the given identifiers. The identifiers are split into aligned power-of-2 blocks of
+ * consecutive identifiers: a single identifier takes one entry of a 16-bit ID list bank
+ * (four per bank) and a larger block takes one identifier/mask pair of a 16-bit ID mask
+ * bank (two per bank). Blocks of two identifiers go to whichever mode needs fewer banks.
+ *
+ * @param ids Standard identifiers to accept
+ * @param num_of_ids Number of identifiers
+ * @param fifo FIFO assigned to the filter banks (CAN_FILTER_FIFO0 or CAN_FILTER_FIFO1)
+ * @param first_bank First filter bank to configure
+ * @return uint32_t Next free filter bank
+ */
+static uint32_t CAN_FilterConfig_Fifo(const uint32_t *ids, uint32_t num_of_ids, uint32_t fifo, uint32_t first_bank)
+{
+	uint32_t list_regs[CAN_FILTER_IDS_PER_BANK];
+	uint32_t mask_regs[2 * CAN_FILTER_MASKS_PER_BANK];
+	uint32_t num_of_list_regs = 0;
+	uint32_t num_of_mask_regs = 0;
+	uint32_t num_of_blocks;
+	uint32_t singles = 0;
+	uint32_t pairs = 0;
+	uint32_t masks = 0;
+	uint32_t pairs_as_list = 0;
+	uint32_t min_banks = UINT32_MAX;
+	uint32_t bank = first_bank;
+
+	num_of_blocks = CAN_FilterPlan_Blocks(ids, num_of_ids, plan_blocks);
+
+	for (uint32_t i = 0; i < num_of_blocks; i++)
 	{
-		Error_Handler();
+		if (plan_blocks[i].size == 1U)
+		{
+			singles++;
+		}
+		else if (plan_blocks[i].size == 2U)
+		{
+			pairs++;
+		}
+		else
+		{
+			masks++;
+		}
+	}
+
+	/* Number of two-identifier blocks accepted as two ID list entries that needs fewer banks */
+	for (uint32_t x = 0; x <= pairs; x++)
+	{
+		uint32_t banks = (singles + 2U * x + CAN_FILTER_IDS_PER_BANK - 1U) / CAN_FILTER_IDS_PER_BANK
+					   + (masks + pairs - x + CAN_FILTER_MASKS_PER_BANK - 1U) / CAN_FILTER_MASKS_PER_BANK;
+
+		if (banks < min_banks)
+		{
+			min_banks = banks;
+			pairs_as_list = x;
+		}
 	}
 
-	/* CAN filter configuration structure for Filter Bank 2 */
-	sFilterConfig.FilterBank = 2;
-	sFilterConfig.FilterIdHigh = 0x20 << 5;
-	sFilterConfig.FilterIdLow = 0x0000;
-	sFilterConfig.FilterMaskIdHigh = (0xFFFF << 3) << 5;
-	sFilterConfig.FilterMaskIdLow = 0x0000;
+	for (uint32_t i = 0; i < num_of_blocks; i++)
+	{
+		const can_filter_block_t *block = &plan_blocks[i];
+
+		if (block->size == 1U || (block->size == 2U && pairs_as_list > 0U))
+		{
+			if (block->size == 2U)
+			{
+				pairs_as_list--;
+			}
+
+			/* Exact identifiers in ID list mode */
+			for (uint32_t id = block->id; id < block->id + block->size; id++)
+			{
+				list_regs[num_of_list_regs++] = CAN_FILTER_16BIT_ID(id);
+
+				if (num_of_list_regs == CAN_FILTER_IDS_PER_BANK)
+				{
+					bank = CAN_FilterConfig_Bank(bank, fifo, CAN_FILTERMODE_IDLIST, list_regs, num_of_list_regs);
+					num_of_list_regs = 0;
+				}
+			}
+		}
+		else
+		{
+			/* Identifier/mask pair in ID mask mode */
+			mask_regs[num_of_mask_regs++] = CAN_FILTER_16BIT_ID(block->id);
+			mask_regs[num_of_mask_regs++] = CAN_FILTER_16BIT_MASK(block->size);
+
+			if (num_of_mask_regs == 2U * CAN_FILTER_MASKS_PER_BANK)
+			{
+				bank = CAN_FilterConfig_Bank(bank, fifo, CAN_FILTERMODE_IDMASK, mask_regs, num_of_mask_regs);
+				num_of_mask_regs = 0;
+			}
+		}
+	}
 
-	/* Configure CAN filter */
-	if (HAL_CAN_ConfigFilter(&hcan1, &sFilterConfig)!= HAL_OK)
+	/* Partially used banks */
+	if (num_of_list_regs > 0U)
 	{
-		Error_Handler();
+		bank = CAN_FilterConfig_Bank(bank, fifo, CAN_FILTERMODE_IDLIST, list_regs, num_of_list_regs);
 	}
 
-	/* CAN filter configuration structure for Filter Bank 3 */
-	sFilterConfig.FilterBank = 3;
-	sFilterConfig.FilterIdHigh = 0x30 << 5;
-	sFilterConfig.FilterIdLow = 0x0000;
-	sFilterConfig.FilterMaskIdHigh = (0xFFFF << 3) << 5;
-	sFilterConfig.FilterMaskIdLow = 0x0000;
+	if (num_of_mask_regs > 0U)
+	{
+		bank = CAN_FilterConfig_Bank(bank, fifo, CAN_FILTERMODE_IDMASK, mask_regs, num_of_mask_regs);
+	}
 
-	/* Configure CAN filter */
-	if (HAL_CAN_ConfigFilter(&hcan1, &sFilterConfig)!= HAL_OK)
+	return bank;
+}
+
+/**
+ * @brief CAN filter planner: splits identifiers into aligned blocks
+ *
+ * Sorts the identifiers and splits them into the fewest aligned power-of-2 blocks of
+ * consecutive identifiers. A block is only used if all of its identifiers are in the
+ * set, so the filters built from the blocks accept exactly the given identifiers.
+ *
+ * @param ids Standard identifiers to accept
+ * @param num_of_ids Number of identifiers
+ * @param blocks Identifier blocks
+ * @return uint32_t Number of identifier blocks
+ */
+static uint32_t CAN_FilterPlan_Blocks(const uint32_t *ids, uint32_t num_of_ids, can_filter_block_t *blocks)
+{
+	uint32_t num_of_sorted = 0;
+	uint32_t num_of_blocks = 0;
+	uint32_t i = 0;
+
+	/* Sorted identifiers without duplicates (insertion sort) */
+	for (uint32_t n = 0; n < num_of_ids; n++)
+	{
+		uint32_t j = num_of_sorted;
+
+		while (j > 0U && plan_ids[j - 1U] > ids[n])
+		{
+			plan_ids[j] = plan_ids[j - 1U];
+			j--;
+		}
+
+		if (j > 0U && plan_ids[j - 1U] == ids[n])
+		{
+			/* Duplicated identifier: undo the shift */
+			while (j < num_of_sorted)
+			{
+				plan_ids[j] = plan_ids[j + 1U];
+				j++;
+			}
+
+			continue;
+		}
+
+		plan_ids[j] = ids[n];
+		num_of_sorted++;
+	}
+
+	/* Largest aligned block of consecutive identifiers starting at each position */
+	while (i < num_of_sorted)
+	{
+		uint32_t size = 1;
+
+		while ((plan_ids[i] & (2U * size - 1U)) == 0U
+			   && i + 2U * size <= num_of_sorted
+			   && plan_ids[i + 2U * size - 1U] == plan_ids[i] + 2U * size - 1U)
+		{
+			size *= 2U;
+		}
+
+		blocks[num_of_blocks].id = plan_ids[i];
+		blocks[num_of_blocks].size = size;
+		num_of_blocks++;
+
+		i += size;
+	}
+
+	return num_of_blocks;
+}
+
+/**
+ * @brief CAN 16-bit filter bank configuration function
+ *
+ * In ID list mode the registers are up to four identifiers; in ID mask mode they are up
+ * to two identifier/mask pairs. Unused entries repeat the first one.
+ *
+ * @param bank Filter bank to configure
+ * @param fifo FIFO assigned to the filter bank (CAN_FILTER_FIFO0 or CAN_FILTER_FIFO1)
+ * @param mode Filter mode (CAN_FILTERMODE_IDLIST or CAN_FILTERMODE_IDMASK)
+ * @param regs 16-bit filter registers
+ * @param num_of_regs Number of filter registers
+ * @return uint32_t Next free filter bank
+ */
+static uint32_t CAN_FilterConfig_Bank(uint32_t bank, uint32_t fifo, uint32_t mode, const uint32_t *regs, uint32_t num_of_regs)
+{
+	if (bank >= CAN_FILTER_NUM_OF_BANKS_MAX)
 	{
 		Error_Handler();
 	}
 
-	/* CAN filter configuration structure for Filter Bank 4 */
-	sFilterConfig.FilterBank = 4;
-	sFilterConfig.FilterIdHigh = 0x40 << 5;
-	sFilterConfig.FilterIdLow = 0x0000;
-	sFilterConfig.FilterMaskIdHigh = (0xFFFF << 3) << 5;
-	sFilterConfig.FilterMaskIdLow = 0x0000;
+	sFilterConfig.FilterActivation = CAN_FILTER_ENABLE;
+	sFilterConfig.FilterFIFOAssignment = fifo;
+	sFilterConfig.FilterMode = mode;
+	sFilterConfig.FilterScale = CAN_FILTERSCALE_16BIT;
+	sFilterConfig.FilterBank = bank;
+
+	if (mode == CAN_FILTERMODE_IDLIST)
+	{
+		/* First, second, third and fourth identifiers */
+		sFilterConfig.FilterIdLow = regs[0];
+		sFilterConfig.FilterMaskIdLow = (num_of_regs > 1U) ? regs[1] : regs[0];
+		sFilterConfig.FilterIdHigh = (num_of_regs > 2U) ? regs[2] : regs[0];
+		sFilterConfig.FilterMaskIdHigh = (num_of_regs > 3U) ? regs[3] : regs[0];
+	}
+	else
+	{
+		/* First and second identifier/mask pairs */
+		sFilterConfig.FilterIdLow = regs[0];
+		sFilterConfig.FilterMaskIdLow = regs[1];
+		sFilterConfig.FilterIdHigh = (num_of_regs > 2U) ? regs[2] : regs[0];
+		sFilterConfig.FilterMaskIdHigh = (num_of_regs > 3U) ? regs[3] : regs[1];
+	}
 
 	/* Configure CAN filter */
 	if (HAL_CAN_ConfigFilter(&hcan1, &sFilterConfig)!= HAL_OK)
 	{
 		Error_Handler();
 	}
+
+	return bank + 1U;
 }
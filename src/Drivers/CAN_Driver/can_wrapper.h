@@ -53,29 +53,9 @@ can_status_t CAN_Wrapper_Init(void);
  * @param rtr Type of frame
  * @param dlc Length of frame
  * @param data Data to transmit
- * @retval None
+ * @retval can_status_t CAN_STATUS_ERROR if the message could not be loaded in a transmit mailbox
  */
 can_status_t CAN_Wrapper_TransmitData(uint32_t id, uint8_t ide, uint8_t rtr, uint8_t dlc, uint8_t *data);
 
-/**
- * @brief Función wrapper recepción de datos CAN.
- *
- * No es static, por lo que puede ser usada por otros archivos.
- *
- * @param id Received identifier
- * @param data Received data
- * @retval  can_status_t
- */
-can_status_t CAN_Wrapper_ReceiveData(uint32_t *id, uint8_t *data);
-
-/**
- * @brief Función wrapper conteo dato recibido por CAN.
- *
- * No es static, por lo que puede ser usada por otros archivos.
- *
- * @return can_status_t
- */
-can_status_t CAN_Wrapper_DataCount(void);
-
 
 #endif /* _CAN_WRAPPER_H_ */
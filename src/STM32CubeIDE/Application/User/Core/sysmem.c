@@ -22,6 +22,7 @@
 
 /* Includes */
 #include <errno.h>
+#include <stddef.h>
 #include <stdint.h>
 
 /**
@@ -29,6 +30,11 @@
  */
 static uint8_t *__sbrk_heap_end = NULL;
 
+/**
+ * Peak heap usage in bytes, reported by ram_monitor.c
+ */
+uint32_t __sbrk_heap_peak = 0;
+
 /**
  * @brief _sbrk() allocates memory to the newlib heap and is used by malloc
  *        and others from the C library
@@ -75,5 +81,11 @@ void *_sbrk(ptrdiff_t incr)
   prev_heap_end = __sbrk_heap_end;
   __sbrk_heap_end += incr;
 
+  /* Track peak heap usage */
+  if ((uint32_t)(__sbrk_heap_end - &_end) > __sbrk_heap_peak)
+  {
+    __sbrk_heap_peak = (uint32_t)(__sbrk_heap_end - &_end);
+  }
+
   return (void *)prev_heap_end;
 }
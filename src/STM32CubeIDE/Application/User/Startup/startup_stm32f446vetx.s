@@ -92,6 +92,21 @@ LoopFillZerobss:
   cmp r2, r4
   bcc FillZerobss
 
+/* Paint free RAM (heap and MSP stack) for the stack high-water scan.
+   Pattern must match RAM_MONITOR_PAINT in ram_monitor.h */
+  ldr r2, =_end
+  ldr r4, =_estack
+  ldr r3, =0xC5C5C5C5
+  b LoopPaintStack
+
+PaintStack:
+  str  r3, [r2]
+  adds r2, r2, #4
+
+LoopPaintStack:
+  cmp r2, r4
+  bcc PaintStack
+
 /* Call the clock system intitialization function.*/
   bl  SystemInit   
 /* Call static constructors */
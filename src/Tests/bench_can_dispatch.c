@@ -0,0 +1,224 @@
+/**
+ * @file bench_can_dispatch.c
+ * @author Subgrupo Control y Periféricos - Elektron Motorsports
+ * @brief Benchmark en host del despacho de recepción CAN: switch por ID contra tabla indexada por ID
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/***********************************************************************************************************************
+ * Included files
+ **********************************************************************************************************************/
+
+/* C includes */
+#include <stdio.h>
+
+/* Reemplazos de CMSIS en host */
+#include "host_cmsis.h"
+
+/* Archivos bajo prueba */
+#include "../Core/Src/buses.c"
+#include "../Core/Src/can_app.c"
+
+/***********************************************************************************************************************
+ * Private macros
+ **********************************************************************************************************************/
+
+/** @brief Mensajes distintos del flujo de prueba */
+#define BENCH_NUM_OF_FRAMES             4096U
+
+/** @brief Pasadas por el flujo de prueba de cada variante */
+#define BENCH_ROUNDS                    2000U
+
+/** @brief Uno de cada BENCH_UNKNOWN_RATIO mensajes tiene un ID fuera del registro */
+#define BENCH_UNKNOWN_RATIO             4U
+
+/** @brief Caso del switch por ID del despacho original: una variable de 1 byte por ID */
+#define BENCH_SWITCH_CASE(module, id_name, id, dir, fifo, field, type, decode, dest, scale, offset, period_ms) \
+    CAN_SIGNAL_IF_LEGACY(module, CAN_SIGNAL_IF_RX(dir, \
+    case CAN_ID_##id_name: \
+        bus_can_input.field = (type)frame->payload_buff[0]; \
+        break;))
+
+#define BENCH_RX_ID(module, id_name, id, dir, fifo, field, type, decode, dest, scale, offset, period_ms) \
+    CAN_SIGNAL_IF_LEGACY(module, CAN_SIGNAL_IF_RX(dir, CAN_ID_##id_name,))
+
+/***********************************************************************************************************************
+ * Private variables definitions
+ **********************************************************************************************************************/
+
+/** @brief IDs del registro de señales que se reciben */
+static const uint32_t bench_rx_ids[] = {CAN_SIGNALS(BENCH_RX_ID)};
+
+/** @brief Flujo de prueba */
+static can_frame_t bench_frames[BENCH_NUM_OF_FRAMES];
+
+/** @brief Estado del generador pseudoaleatorio */
+static uint32_t bench_seed = 0x12345678UL;
+
+/***********************************************************************************************************************
+ * Stubs
+ **********************************************************************************************************************/
+
+uint32_t SystemCoreClock = 180000000UL;
+volatile uint32_t can_tx_slot_count;
+static can_error_stats_t bench_error_stats;
+static can_tx_queue_stats_t bench_tx_queue_stats;
+static can_express_stats_t bench_express_stats;
+static app_startup_stats_t bench_startup_stats;
+static ram_monitor_stats_t bench_ram_stats;
+static rampa_pedal_slew_t bench_slew;
+static scheduler_cpu_stats_t bench_cpu_stats;
+
+uint32_t HAL_GetTick(void) { return 0U; }
+uint32_t TIMEBASE_Get_TimeUs(void) { return 0U; }
+bool CAN_HW_Get_ReceivedFrame(can_frame_t *frame) { return false; }
+uint32_t CAN_HW_Get_RxOverflowCount(can_rx_fifo_t fifo) { return 0U; }
+void CAN_HW_Process(void) {}
+const can_error_stats_t *CAN_HW_Get_ErrorStats(void) { return &bench_error_stats; }
+const can_tx_queue_stats_t *CAN_HW_Get_TxQueueStats(void) { return &bench_tx_queue_stats; }
+const can_express_stats_t *CAN_HW_Get_ExpressStats(void) { return &bench_express_stats; }
+void CAN_TX_Process(uint32_t now_ms) {}
+void CAN_TX_Send_All(const typedef_bus2_t *bus) {}
+can_status_t CAN_TX_Send_Frame(uint32_t id, const uint8_t *payload, uint8_t length) { return CAN_STATUS_OK; }
+uint32_t CAN_TX_Get_ErrorCount(void) { return 0U; }
+const app_startup_stats_t *MX_APP_Get_StartupStats(void) { return &bench_startup_stats; }
+const ram_monitor_stats_t *RAM_MONITOR_Get_Stats(void) { return &bench_ram_stats; }
+const rampa_pedal_slew_t *RAMPA_PEDAL_Get_Slew(void) { return &bench_slew; }
+const scheduler_cpu_stats_t *SCHEDULER_Get_CpuStats(void) { return &bench_cpu_stats; }
+#if PROFILING_ENABLED == 1
+static profiling_stats_t bench_profiling_stats;
+const profiling_stats_t *PROFILING_Get_Stats(profiling_probe_t probe) { return &bench_profiling_stats; }
+#endif /* PROFILING_ENABLED */
+
+/***********************************************************************************************************************
+ * Private functions implementation
+ **********************************************************************************************************************/
+
+/**
+ * @brief Generador pseudoaleatorio (LCG), determinístico entre corridas.
+ *
+ * @param None
+ * @return uint32_t Valor pseudoaleatorio
+ */
+static uint32_t BENCH_Rand(void)
+{
+    bench_seed = (bench_seed * 1664525UL) + 1013904223UL;
+
+    return bench_seed >> 8;
+}
+
+/**
+ * @brief Despacho original: switch por ID, una variable de 1 byte por ID.
+ *
+ * @param frame Mensaje recibido
+ * @retval None
+ */
+static __attribute__((noinline)) void BENCH_Store_Switch(const can_frame_t *frame)
+{
+    switch (frame->id)
+    {
+    CAN_SIGNALS(BENCH_SWITCH_CASE)
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief Despacho por tabla: solo la búsqueda en can_rx_dispatch_table y la copia del payload.
+ *
+ * @param frame Mensaje recibido
+ * @retval None
+ */
+static __attribute__((noinline)) void BENCH_Store_Table(const can_frame_t *frame)
+{
+    const can_rx_dispatch_t *entry;
+    uint8_t *dest;
+
+    if (frame->id >= CAN_RX_DISPATCH_SIZE)
+    {
+        return;
+    }
+
+    entry = &can_rx_dispatch_table[frame->id];
+    dest = (uint8_t *)&bus_can_input + entry->offset;
+
+    for (uint32_t i = 0; i < entry->width; i++)
+    {
+        dest[i] = frame->payload_buff[i];
+    }
+}
+
+/**
+ * @brief Tiempo promedio por mensaje de una variante de despacho.
+ *
+ * @param store Variante de despacho
+ * @return double Tiempo por mensaje [ns]
+ */
+static double BENCH_Run(void (*store)(const can_frame_t *))
+{
+    uint64_t start = HOST_Get_TimeNs();
+
+    for (uint32_t round = 0; round < BENCH_ROUNDS; round++)
+    {
+        for (uint32_t i = 0; i < BENCH_NUM_OF_FRAMES; i++)
+        {
+            store(&bench_frames[i]);
+        }
+    }
+
+    return (double)(HOST_Get_TimeNs() - start) / ((double)BENCH_ROUNDS * BENCH_NUM_OF_FRAMES);
+}
+
+/***********************************************************************************************************************
+ * Public functions implementation
+ **********************************************************************************************************************/
+
+int main(void)
+{
+    typedef_bus3_t switch_result;
+    double switch_ns;
+    double table_ns;
+    double store_ns;
+
+    for (uint32_t i = 0; i < BENCH_NUM_OF_FRAMES; i++)
+    {
+        can_frame_t *frame = &bench_frames[i];
+
+        frame->id = ((BENCH_Rand() % BENCH_UNKNOWN_RATIO) == 0U)
+                  ? (BENCH_Rand() & 0x7FFU)
+                  : bench_rx_ids[BENCH_Rand() % (sizeof(bench_rx_ids) / sizeof(bench_rx_ids[0]))];
+        frame->payload_length = PAYLOAD_MAX_LENGTH;
+
+        for (uint32_t j = 0; j < PAYLOAD_MAX_LENGTH; j++)
+        {
+            frame->payload_buff[j] = (uint8_t)BENCH_Rand();
+        }
+    }
+
+    /* Las dos variantes deben dejar el mismo bus de entrada CAN */
+    switch_ns = BENCH_Run(BENCH_Store_Switch);
+    switch_result = bus_can_input;
+    memset(&bus_can_input, 0, sizeof(bus_can_input));
+    table_ns = BENCH_Run(BENCH_Store_Table);
+
+    if (memcmp(&switch_result, &bus_can_input, sizeof(bus_can_input)) != 0)
+    {
+        printf("FAIL: el despacho por tabla no coincide con el switch\n");
+        return 1;
+    }
+
+    store_ns = BENCH_Run(CAN_APP_Store_ReceivedMessage);
+
+    printf("IDs del registro: %u, mensajes: %u x %u, 1 de cada %u fuera del registro\n",
+           (unsigned)(sizeof(bench_rx_ids) / sizeof(bench_rx_ids[0])), BENCH_NUM_OF_FRAMES, BENCH_ROUNDS,
+           BENCH_UNKNOWN_RATIO);
+    printf("switch por ID                   %6.2f ns/mensaje\n", switch_ns);
+    printf("tabla indexada por ID           %6.2f ns/mensaje\n", table_ns);
+    printf("CAN_APP_Store_ReceivedMessage   %6.2f ns/mensaje (tabla + frescura + variables cambiadas)\n", store_ns);
+
+    return 0;
+}
@@ -0,0 +1,183 @@
+/**
+ * @file bench_decode_data.c
+ * @author Subgrupo Control y Periféricos - Elektron Motorsports
+ * @brief Benchmark en host de la decodificación: todas las variables contra solo las que cambiaron
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/***********************************************************************************************************************
+ * Included files
+ **********************************************************************************************************************/
+
+/* C includes */
+#include <stdio.h>
+#include <string.h>
+
+/* Reemplazos de CMSIS en host */
+#include "host_cmsis.h"
+
+/* Archivos bajo prueba */
+#include "../Core/Src/buses.c"
+#include "../Core/Src/decode_data.c"
+
+/***********************************************************************************************************************
+ * Private macros
+ **********************************************************************************************************************/
+
+/** @brief Pasadas de DECODE_DATA_Process del flujo de prueba (una por ms, ver SCHEDULER_TASKS) */
+#define BENCH_NUM_OF_PASSES             1000U
+
+/** @brief Pasadas por el flujo de prueba de cada variante */
+#define BENCH_ROUNDS                    20000U
+
+/** @brief Una de cada BENCH_CHANGE_RATIO recepciones de una señal trae un valor distinto */
+#define BENCH_CHANGE_RATIO              2U
+
+/** @brief Marca la señal si en esta pasada llega su frame y su valor cambió */
+#define BENCH_DIRTY_SIGNAL(module, id_name, id, dir, fifo, field, type, decode, dest, scale, offset, period_ms) \
+    CAN_SIGNAL_IF_RX(dir, \
+    if ((pass % (period_ms)) == (id % (period_ms)) && (BENCH_Rand() % BENCH_CHANGE_RATIO) == 0U) \
+    { \
+        mask |= RX_SIGNAL_MASK(kRX_SIGNAL_##id_name); \
+    })
+
+/** @brief Escribe un valor nuevo en el bus de entrada CAN si la señal está en la máscara */
+#define BENCH_STORE_SIGNAL(module, id_name, id, dir, fifo, field, type, decode, dest, scale, offset, period_ms) \
+    CAN_SIGNAL_IF_RX(dir, \
+    if ((mask & RX_SIGNAL_MASK(kRX_SIGNAL_##id_name)) != 0U) \
+    { \
+        bus_can_input.field = (type)BENCH_Rand(); \
+    })
+
+/***********************************************************************************************************************
+ * Private variables definitions
+ **********************************************************************************************************************/
+
+/** @brief Variables con valor nuevo de cada pasada del flujo de prueba */
+static uint32_t bench_dirty[BENCH_NUM_OF_PASSES];
+
+/** @brief Estado del generador pseudoaleatorio */
+static uint32_t bench_seed = 0x0BADF00DUL;
+
+/***********************************************************************************************************************
+ * Stubs
+ **********************************************************************************************************************/
+
+uint32_t can_rx_dirty_signals;
+
+/***********************************************************************************************************************
+ * Private functions implementation
+ **********************************************************************************************************************/
+
+/**
+ * @brief Generador pseudoaleatorio (LCG), determinístico entre corridas.
+ *
+ * @param None
+ * @return uint32_t Valor pseudoaleatorio
+ */
+static uint32_t BENCH_Rand(void)
+{
+    bench_seed = (bench_seed * 1664525UL) + 1013904223UL;
+
+    return bench_seed >> 8;
+}
+
+/**
+ * @brief Recorre el flujo de prueba escribiendo valores nuevos en el bus de entrada CAN.
+ *
+ * @param full  Decodifica todas las variables en cada pasada (sin máscara dirty)
+ * @retval None
+ */
+static void BENCH_Replay(bool full)
+{
+    bench_seed = 0x5EEDUL;
+
+    for (uint32_t pass = 0; pass < BENCH_NUM_OF_PASSES; pass++)
+    {
+        uint32_t mask = bench_dirty[pass];
+
+        CAN_SIGNALS(BENCH_STORE_SIGNAL)
+
+        can_rx_dirty_signals = full ? RX_SIGNAL_ALL_MASK : mask;
+        DECODE_DATA_Process();
+    }
+}
+
+/**
+ * @brief Tiempo promedio por pasada de una variante de decodificación.
+ *
+ * @param full  Decodifica todas las variables en cada pasada (sin máscara dirty)
+ * @return double Tiempo por pasada [ns]
+ */
+static double BENCH_Run(bool full)
+{
+    uint64_t start = HOST_Get_TimeNs();
+
+    for (uint32_t round = 0; round < BENCH_ROUNDS; round++)
+    {
+        for (uint32_t pass = 0; pass < BENCH_NUM_OF_PASSES; pass++)
+        {
+            can_rx_dirty_signals = full ? RX_SIGNAL_ALL_MASK : bench_dirty[pass];
+            DECODE_DATA_Process();
+        }
+    }
+
+    return (double)(HOST_Get_TimeNs() - start) / ((double)BENCH_ROUNDS * BENCH_NUM_OF_PASSES);
+}
+
+/***********************************************************************************************************************
+ * Public functions implementation
+ **********************************************************************************************************************/
+
+int main(void)
+{
+    static typedef_bus1_t initial_data;
+    static typedef_bus3_t initial_input;
+    static typedef_bus1_t dirty_result;
+    uint32_t dirty_signals = 0;
+    double full_ns;
+    double dirty_ns;
+
+    for (uint32_t pass = 0; pass < BENCH_NUM_OF_PASSES; pass++)
+    {
+        uint32_t mask = 0;
+
+        CAN_SIGNALS(BENCH_DIRTY_SIGNAL)
+
+        bench_dirty[pass] = mask;
+        dirty_signals += (uint32_t)__builtin_popcount(mask);
+    }
+
+    /* Las dos variantes deben dejar el mismo bus de datos con los mismos valores de entrada */
+    memcpy(&initial_data, &bus_data, sizeof(bus_data));
+    memcpy(&initial_input, &bus_can_input, sizeof(bus_can_input));
+
+    BENCH_Replay(false);
+    memcpy(&dirty_result, &bus_data, sizeof(bus_data));
+
+    memcpy(&bus_data, &initial_data, sizeof(bus_data));
+    memcpy(&bus_can_input, &initial_input, sizeof(bus_can_input));
+
+    BENCH_Replay(true);
+
+    if (memcmp(&dirty_result, &bus_data, sizeof(bus_data)) != 0)
+    {
+        printf("FAIL: la decodificación de variables cambiadas no coincide con la completa\n");
+        return 1;
+    }
+
+    full_ns = BENCH_Run(true);
+    dirty_ns = BENCH_Run(false);
+
+    printf("variables RX: %u, pasadas: %u x %u, %.2f variables cambiadas por pasada\n",
+           (unsigned)kRX_SIGNAL_COUNT, BENCH_NUM_OF_PASSES, BENCH_ROUNDS,
+           (double)dirty_signals / BENCH_NUM_OF_PASSES);
+    printf("todas las variables             %6.2f ns/pasada\n", full_ns);
+    printf("solo variables cambiadas        %6.2f ns/pasada\n", dirty_ns);
+
+    return 0;
+}
@@ -0,0 +1,62 @@
+/**
+ * @file host_cmsis.h
+ * @author Subgrupo Control y Periféricos - Elektron Motorsports
+ * @brief Reemplazos en host de intrínsecos CMSIS y del timebase de HAL, para pruebas y benchmarks
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef _HOST_CMSIS_H_
+#define _HOST_CMSIS_H_
+
+/***********************************************************************************************************************
+ * Included files
+ **********************************************************************************************************************/
+
+/* C includes */
+#include <stdint.h>
+#include <time.h>
+
+/* STM32 HAL include (los intrínsecos se reemplazan después de declararse) */
+#include "main.h"
+
+/***********************************************************************************************************************
+ * Macros
+ **********************************************************************************************************************/
+
+/*
+ * Los intrínsecos de cmsis_gcc.h son ensamblador de Cortex-M. Definidos como macros después
+ * de incluir main.h, reemplazan las llamadas del archivo bajo prueba incluido a continuación.
+ * En host no hay interrupciones, por lo que las secciones críticas no hacen nada.
+ */
+#define __get_PRIMASK()                 0U
+#define __set_PRIMASK(primask)          ((void)(primask))
+#define __disable_irq()                 ((void)0)
+#define __enable_irq()                  ((void)0)
+#define __DMB()                         __sync_synchronize()
+#define __DSB()                         __sync_synchronize()
+#define __ISB()                         ((void)0)
+
+/***********************************************************************************************************************
+ * Public functions implementation
+ **********************************************************************************************************************/
+
+/**
+ * @brief Tiempo monotónico del host.
+ *
+ * @param None
+ * @return uint64_t Tiempo [ns]
+ */
+static inline uint64_t HOST_Get_TimeNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+#endif /* _HOST_CMSIS_H_ */
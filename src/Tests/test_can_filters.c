@@ -0,0 +1,321 @@
+/**
+ * @file test_can_filters.c
+ * @author Subgrupo Control y Periféricos - Elektron Motorsports
+ * @brief Prueba en host del planificador de filtros CAN de 16 bits (can_wrapper.c)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/***********************************************************************************************************************
+ * Included files
+ **********************************************************************************************************************/
+
+/* C includes */
+#include <stdio.h>
+#include <string.h>
+
+/* Reemplazos de CMSIS en host */
+#include "host_cmsis.h"
+
+/* Archivo bajo prueba */
+#include "../Drivers/CAN_Driver/can_wrapper.c"
+
+/***********************************************************************************************************************
+ * Private macros
+ **********************************************************************************************************************/
+
+/** @brief Número de standard identifiers */
+#define TEST_NUM_OF_IDS                 0x800U
+
+/** @brief Bit RTR del mapeo de 16 bits */
+#define TEST_16BIT_RTR                  0x10U
+
+/** @brief Ningún FIFO: el ID no debe aceptarse */
+#define TEST_NO_FIFO                    0xFFU
+
+/** @brief Conjuntos de IDs aleatorios del planificador */
+#define TEST_RANDOM_SETS                2000U
+
+#define TEST_EXPECTED_ID(module, id_name, id, dir, fifo, field, type, decode, dest, scale, offset, period_ms) \
+    CAN_SIGNAL_IF_LEGACY(module, CAN_SIGNAL_IF_RX(dir, test_expected_fifo[CAN_ID_##id_name] = (fifo);))
+
+#define TEST_EXPECTED_PACKED_ID(module, id_name, id, dir, fifo, first_id_name, first_field) \
+    CAN_SIGNAL_IF_PACKED(module, CAN_SIGNAL_IF_RX(dir, test_expected_fifo[CAN_ID_##id_name] = (fifo);))
+
+/***********************************************************************************************************************
+ * Private variables definitions
+ **********************************************************************************************************************/
+
+/** @brief Bancos configurados con HAL_CAN_ConfigFilter */
+static CAN_FilterTypeDef test_banks[CAN_FILTER_NUM_OF_BANKS_MAX];
+
+/** @brief Banco configurado al menos una vez */
+static bool test_bank_used[CAN_FILTER_NUM_OF_BANKS_MAX];
+
+/** @brief FIFO esperado de cada ID (TEST_NO_FIFO si no se acepta) */
+static uint8_t test_expected_fifo[TEST_NUM_OF_IDS];
+
+/** @brief Bancos configurados en modo máscara */
+static uint32_t test_mask_banks;
+
+/** @brief Llamadas a Error_Handler */
+static uint32_t test_errors;
+
+/** @brief Estado del generador pseudoaleatorio */
+static uint32_t test_seed = 0x2468ACE1UL;
+
+/***********************************************************************************************************************
+ * Stubs
+ **********************************************************************************************************************/
+
+CAN_HandleTypeDef hcan1;
+TIM_HandleTypeDef htim7;
+
+void Error_Handler(void) { test_errors++; }
+void MX_CAN1_Init(void) {}
+void MX_TIM7_Init(void) {}
+HAL_StatusTypeDef HAL_CAN_Start(CAN_HandleTypeDef *hcan) { return HAL_OK; }
+HAL_StatusTypeDef HAL_CAN_ActivateNotification(CAN_HandleTypeDef *hcan, uint32_t its) { return HAL_OK; }
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim) { return HAL_OK; }
+
+HAL_StatusTypeDef HAL_CAN_AddTxMessage(CAN_HandleTypeDef *hcan, CAN_TxHeaderTypeDef *header, uint8_t data[],
+                                       uint32_t *mailbox)
+{
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_CAN_ConfigFilter(CAN_HandleTypeDef *hcan, CAN_FilterTypeDef *config)
+{
+    if (config->FilterBank < CAN_FILTER_NUM_OF_BANKS_MAX)
+    {
+        test_banks[config->FilterBank] = *config;
+        test_bank_used[config->FilterBank] = true;
+        test_mask_banks += (config->FilterMode == CAN_FILTERMODE_IDMASK) ? 1U : 0U;
+    }
+
+    return HAL_OK;
+}
+
+/***********************************************************************************************************************
+ * Private functions implementation
+ **********************************************************************************************************************/
+
+/**
+ * @brief Resultado del filtrado de bxCAN para un registro de 16 bits.
+ *
+ * Compara el registro con cada banco configurado de 16 bits: en modo lista con cada uno de
+ * sus cuatro IDs, y en modo máscara con cada uno de sus dos pares ID/máscara.
+ *
+ * @param reg           Registro de 16 bits del mensaje (STID << 5 | RTR | IDE)
+ * @param fifo          FIFO en el que debe aceptarse el mensaje
+ * @param wrong_fifo    Bancos de otro FIFO que aceptan el mensaje
+ * @retval Número de bancos que aceptan el mensaje
+ */
+static uint32_t TEST_Match(uint32_t reg, uint32_t fifo, uint32_t *wrong_fifo)
+{
+    uint32_t matches = 0;
+
+    *wrong_fifo = 0;
+
+    for (uint32_t bank = 0; bank < CAN_FILTER_NUM_OF_BANKS_MAX; bank++)
+    {
+        const CAN_FilterTypeDef *f = &test_banks[bank];
+        bool match;
+
+        if (!test_bank_used[bank])
+        {
+            continue;
+        }
+
+        if (f->FilterMode == CAN_FILTERMODE_IDLIST)
+        {
+            match = (reg == f->FilterIdLow) || (reg == f->FilterMaskIdLow)
+                 || (reg == f->FilterIdHigh) || (reg == f->FilterMaskIdHigh);
+        }
+        else
+        {
+            match = (((reg ^ f->FilterIdLow) & f->FilterMaskIdLow) == 0U)
+                 || (((reg ^ f->FilterIdHigh) & f->FilterMaskIdHigh) == 0U);
+        }
+
+        if (match)
+        {
+            matches++;
+            *wrong_fifo += (f->FilterFIFOAssignment != fifo) ? 1U : 0U;
+        }
+    }
+
+    return matches;
+}
+
+/**
+ * @brief Verifica que los bancos configurados acepten exactamente los IDs esperados.
+ *
+ * Todos los bancos que aceptan un ID deben ser de su FIFO, y ningún remote frame se acepta.
+ *
+ * @param name      Nombre del caso
+ * @param expected  FIFO esperado de cada ID
+ * @retval Número de errores
+ */
+static uint32_t TEST_Check_Banks(const char *name, const uint8_t *expected)
+{
+    uint32_t failures = 0;
+
+    for (uint32_t id = 0; id < TEST_NUM_OF_IDS; id++)
+    {
+        uint32_t wrong_fifo;
+        uint32_t matches = TEST_Match(CAN_FILTER_16BIT_ID(id), expected[id], &wrong_fifo);
+
+        if (expected[id] == TEST_NO_FIFO && matches != 0U)
+        {
+            printf("FAIL %s: ID 0x%03X aceptado sin estar en el conjunto\n", name, (unsigned)id);
+            failures++;
+        }
+        else if (expected[id] != TEST_NO_FIFO && (matches == 0U || wrong_fifo != 0U))
+        {
+            printf("FAIL %s: ID 0x%03X no aceptado solo en FIFO%u\n", name, (unsigned)id, expected[id]);
+            failures++;
+        }
+
+        if (TEST_Match(CAN_FILTER_16BIT_ID(id) | TEST_16BIT_RTR, expected[id], &wrong_fifo) != 0U)
+        {
+            printf("FAIL %s: remote frame de ID 0x%03X aceptado\n", name, (unsigned)id);
+            failures++;
+        }
+    }
+
+    return failures;
+}
+
+/**
+ * @brief Generador pseudoaleatorio (LCG), determinístico entre corridas.
+ *
+ * @param None
+ * @return uint32_t Valor pseudoaleatorio
+ */
+static uint32_t TEST_Rand(void)
+{
+    test_seed = (test_seed * 1103515245UL) + 12345UL;
+
+    return test_seed >> 8;
+}
+
+/**
+ * @brief Filtros de los IDs recibidos del registro de señales CAN.
+ *
+ * @param None
+ * @retval Número de errores
+ */
+static uint32_t TEST_Registry(void)
+{
+    uint32_t failures;
+    uint32_t banks = 0;
+
+    memset(test_expected_fifo, TEST_NO_FIFO, sizeof(test_expected_fifo));
+    CAN_SIGNALS(TEST_EXPECTED_ID)
+    CAN_PACKED_FRAMES(TEST_EXPECTED_PACKED_ID)
+
+    memset(test_bank_used, 0, sizeof(test_bank_used));
+    test_errors = 0;
+
+    CAN_FilterConfig();
+
+    failures = TEST_Check_Banks("registro", test_expected_fifo) + test_errors;
+
+    for (uint32_t bank = 0; bank < CAN_FILTER_NUM_OF_BANKS_MAX; bank++)
+    {
+        banks += test_bank_used[bank] ? 1U : 0U;
+    }
+
+    printf("registro: %u IDs en FIFO0, %u IDs en FIFO1, %u bancos\n",
+           (unsigned)CAN_FILTER_NUM_OF_IDS(fifo0_ids), (unsigned)CAN_FILTER_NUM_OF_IDS(fifo1_ids), (unsigned)banks);
+
+    return failures;
+}
+
+/**
+ * @brief Filtros de conjuntos de IDs aleatorios, agrupados para formar bloques de máscara.
+ *
+ * @param None
+ * @retval Número de errores
+ */
+static uint32_t TEST_Random_Sets(void)
+{
+    static uint8_t expected[TEST_NUM_OF_IDS];
+    uint32_t fifo0[CAN_FILTER_MAX_IDS];
+    uint32_t fifo1[CAN_FILTER_MAX_IDS];
+    uint32_t failures = 0;
+
+    for (uint32_t set = 0; set < TEST_RANDOM_SETS && failures == 0U; set++)
+    {
+        uint32_t base = TEST_Rand() & 0x7C0U;
+        uint32_t span = 8U << (TEST_Rand() % 4U);
+        uint32_t num_of_fifo0 = 0;
+        uint32_t num_of_fifo1 = 0;
+        uint32_t bank;
+        char name[32];
+
+        memset(expected, TEST_NO_FIFO, sizeof(expected));
+
+        /* IDs agrupados (con repeticiones) en una ventana, repartidos entre FIFOs */
+        for (uint32_t n = TEST_Rand() % 24U; n > 0U; n--)
+        {
+            uint32_t id = (base + (TEST_Rand() % span)) & 0x7FFU;
+
+            if (expected[id] == TEST_NO_FIFO)
+            {
+                expected[id] = (uint8_t)(TEST_Rand() & 1U);
+            }
+
+            if (expected[id] == CAN_FILTER_FIFO0)
+            {
+                fifo0[num_of_fifo0++] = id;
+            }
+            else
+            {
+                fifo1[num_of_fifo1++] = id;
+            }
+        }
+
+        memset(test_bank_used, 0, sizeof(test_bank_used));
+        test_errors = 0;
+
+        bank = CAN_FilterConfig_Fifo(fifo1, num_of_fifo1, CAN_FILTER_FIFO1, 0);
+        bank = CAN_FilterConfig_Fifo(fifo0, num_of_fifo0, CAN_FILTER_FIFO0, bank);
+
+        if (test_errors != 0U)
+        {
+            /* No cabe en los 14 bancos: el planificador lo reporta y no se verifica */
+            continue;
+        }
+
+        snprintf(name, sizeof(name), "conjunto %u", (unsigned)set);
+        failures += TEST_Check_Banks(name, expected);
+    }
+
+    printf("conjuntos aleatorios: %u, %u bancos en modo máscara\n", TEST_RANDOM_SETS, (unsigned)test_mask_banks);
+
+    return failures;
+}
+
+/***********************************************************************************************************************
+ * Public functions implementation
+ **********************************************************************************************************************/
+
+int main(void)
+{
+    uint32_t failures = TEST_Registry() + TEST_Random_Sets();
+
+    if (failures != 0U)
+    {
+        printf("FAIL: %u errores\n", (unsigned)failures);
+        return 1;
+    }
+
+    printf("OK\n");
+
+    return 0;
+}
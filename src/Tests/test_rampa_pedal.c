@@ -0,0 +1,271 @@
+/**
+ * @file test_rampa_pedal.c
+ * @author Subgrupo Control y Periféricos - Elektron Motorsports
+ * @brief Prueba en host de las tablas de rampa pedal contra las rampas por tramos originales, y del limitador
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/***********************************************************************************************************************
+ * Included files
+ **********************************************************************************************************************/
+
+/* C includes */
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+/* Reemplazos de CMSIS en host */
+#include "host_cmsis.h"
+
+/* Archivos bajo prueba */
+#include "../Core/Src/buses.c"
+#include "../Core/Src/rampa_pedal.c"
+
+/***********************************************************************************************************************
+ * Private macros
+ **********************************************************************************************************************/
+
+/** @brief Valores de pedal verificados: todos los del byte de pedal */
+#define TEST_NUM_OF_PEDALS              256U
+
+/** @brief Pedal máximo dentro de rango */
+#define TEST_PEDAL_MAX                  100U
+
+/** @brief Tiempo [ms] de la prueba del limitador, menor al de alcanzar el objetivo */
+#define TEST_SLEW_MS                    40U
+
+/***********************************************************************************************************************
+ * Private variables definitions
+ **********************************************************************************************************************/
+
+/** @brief Liberación de la tarea de rampa pedal reportada por el scheduler */
+static uint32_t test_release_ms;
+
+/***********************************************************************************************************************
+ * Stubs
+ **********************************************************************************************************************/
+
+uint32_t DECODE_DATA_Take_UpdatedSignals(decode_consumer_t consumer) { return 0U; }
+uint32_t SCHEDULER_Get_ReleaseMs(void) { return test_release_ms; }
+
+/***********************************************************************************************************************
+ * Private functions implementation
+ **********************************************************************************************************************/
+
+/*
+ * Rampas por tramos originales (rampa_pedal.c antes de las tablas), copiadas sin cambios:
+ * mismo tipo de pedal, mismas constantes double y resultado en float.
+ */
+
+static float TEST_Rampa_Eco(rx_var_t pedal)
+{
+    float velocidad = 0;
+
+    if (pedal >= 0 && pedal < 20)
+    {
+        velocidad = pedal * 0.25;
+    }
+    else if (pedal >= 20 && pedal < 40)
+    {
+        velocidad = (0.5 * pedal) - 5;
+    }
+    else if (pedal >= 40 && pedal < 60)
+    {
+        velocidad = (0.75 * pedal) - 15;
+    }
+    else if (pedal >= 60 && pedal < 80)
+    {
+        velocidad = (1.5 * pedal) - 60;
+    }
+    else if (pedal >= 80 && pedal < 100)
+    {
+        velocidad = (2 * pedal) - 100;
+    }
+
+    return velocidad;
+}
+
+static float TEST_Rampa_Normal(rx_var_t pedal)
+{
+    float velocidad = 0;
+
+    if (pedal >= 0 && pedal < 20)
+    {
+        velocidad = pedal * 0.5;
+    }
+    else if (pedal >= 20 && pedal < 40)
+    {
+        velocidad = pedal - 10;
+    }
+    else if (pedal >= 40 && pedal < 60)
+    {
+        velocidad = (2 * pedal) - 50;
+    }
+    else if (pedal >= 60 && pedal < 80)
+    {
+        velocidad = pedal + 10;
+    }
+    else if (pedal >= 80 && pedal < 100)
+    {
+        velocidad = (0.5 * pedal) + 50;
+    }
+
+    return velocidad;
+}
+
+static float TEST_Rampa_Sport(rx_var_t pedal)
+{
+    float velocidad = 0;
+
+    if (pedal >= 0 && pedal < 20)
+    {
+        velocidad = pedal * 1.5;
+    }
+    else if (pedal >= 20 && pedal < 40)
+    {
+        velocidad = (1.25 * pedal) + 5;
+    }
+    else if (pedal >= 40 && pedal < 60)
+    {
+        velocidad = (1 * pedal) + 15;
+    }
+    else if (pedal >= 60 && pedal < 80)
+    {
+        velocidad = (0.75 * pedal) + 30;
+    }
+    else if (pedal >= 80 && pedal < 100)
+    {
+        velocidad = (0.5 * pedal) + 50;
+    }
+
+    return velocidad;
+}
+
+/**
+ * @brief Nivel esperado para un valor de pedal, en el punto fijo de CAN.
+ *
+ * Bajo 100 es la rampa original redondeada como la enviaba RAMPA_PEDAL_Send_Velocidad. Sobre
+ * 100 es 0, como la rampa original. En 100 el último tramo se cierra (nivel 100): la rampa
+ * original daba 0 con el pedal a fondo, y el mapa usa el nivel de su último punto.
+ *
+ * @param mode  Modo de manejo
+ * @param pedal Valor de pedal [0:255]
+ * @retval Nivel esperado
+ */
+static uint16_t TEST_Expected(uint32_t mode, uint32_t pedal)
+{
+    static float (*const rampas[RAMPA_PEDAL_NUM_OF_MODES])(rx_var_t) =
+    {
+        [kDRIVING_MODE_ECO]     = TEST_Rampa_Eco,
+        [kDRIVING_MODE_NORMAL]  = TEST_Rampa_Normal,
+        [kDRIVING_MODE_SPORT]   = TEST_Rampa_Sport,
+    };
+
+    if (pedal == TEST_PEDAL_MAX)
+    {
+        return (uint16_t)(RAMPA_PEDAL_MAP_MAX_LEVEL << CAN_PEDAL_FRAC_BITS);
+    }
+
+    return (uint16_t)round(rampas[mode]((rx_var_t)pedal) * (float)(1UL << CAN_PEDAL_FRAC_BITS));
+}
+
+/**
+ * @brief Salida del limitador después de TEST_SLEW_MS con el pedal a fondo en ECO.
+ *
+ * @param step_ms Separación [ms] entre pasadas de la rampa (1: ninguna liberación perdida)
+ * @retval Salida del limitador [nivel, punto fijo]
+ */
+static uint32_t TEST_Slew_Output(uint32_t step_ms)
+{
+    memset(&rampa_pedal_slew, 0, sizeof(rampa_pedal_slew));
+    rampa_last_calibration = NULL;
+    rampa_release_valid = false;
+
+    bus_data.driving_mode = kDRIVING_MODE_ECO;
+    bus_data.Rx_Peripherals.hombre_muerto = kHOMBRE_MUERTO_OFF;
+    bus_can_input.pedal = (CAN_PEDAL_TYPE)(TEST_PEDAL_MAX << CAN_PEDAL_FRAC_BITS);
+
+    for (test_release_ms = 0; test_release_ms <= TEST_SLEW_MS; test_release_ms += step_ms)
+    {
+        RAMPA_PEDAL_Process();
+    }
+
+    return rampa_pedal_slew.output;
+}
+
+/**
+ * @brief El limitador avanza lo mismo si el scheduler perdió liberaciones de la rampa.
+ *
+ * @param None
+ * @retval Número de errores
+ */
+static uint32_t TEST_Slew(void)
+{
+    uint32_t every_ms = TEST_Slew_Output(1U);
+    uint32_t skipped = TEST_Slew_Output(TEST_SLEW_MS / 4U);
+    uint32_t single = TEST_Slew_Output(TEST_SLEW_MS);
+
+    printf("limitador: salida %u en %u ms, %u y %u con liberaciones perdidas\n", (unsigned)every_ms,
+           TEST_SLEW_MS, (unsigned)skipped, (unsigned)single);
+
+    if (every_ms == 0U || every_ms >= RAMPA_PEDAL_SLEW_FIXED(RAMPA_PEDAL_MAP_MAX_LEVEL)
+            || skipped != every_ms || single != every_ms)
+    {
+        printf("FAIL limitador: el paso no corresponde al tiempo transcurrido\n");
+        return 1U;
+    }
+
+    return 0U;
+}
+
+/***********************************************************************************************************************
+ * Public functions implementation
+ **********************************************************************************************************************/
+
+int main(void)
+{
+    const rampa_pedal_calibration_t *calibration;
+    uint32_t failures = 0;
+
+    RAMPA_PEDAL_Init();
+    calibration = rampa_pedal_active;
+
+    for (uint32_t mode = 0; mode < RAMPA_PEDAL_NUM_OF_MODES; mode++)
+    {
+        for (uint32_t pedal = 0; pedal < TEST_NUM_OF_PEDALS; pedal++)
+        {
+            uint16_t expected = TEST_Expected(mode, pedal);
+#if CAN_HIGH_RES_PEDAL == 1
+            /* Sin tablas: la rampa interpola el mapa con el pedal en el punto fijo de CAN */
+            uint16_t actual = RAMPA_PEDAL_Interpolate(calibration->map.points[mode], pedal << CAN_PEDAL_FRAC_BITS);
+#else
+            uint16_t actual = calibration->lut[mode][pedal];
+#endif /* CAN_HIGH_RES_PEDAL */
+
+            if (actual != expected)
+            {
+                printf("FAIL modo %u, pedal %u: %u, esperado %u\n", (unsigned)mode, (unsigned)pedal,
+                       (unsigned)actual, (unsigned)expected);
+                failures++;
+            }
+        }
+    }
+
+    printf("tablas: %u modos x %u valores de pedal\n", (unsigned)RAMPA_PEDAL_NUM_OF_MODES, TEST_NUM_OF_PEDALS);
+
+    failures += TEST_Slew();
+
+    if (failures != 0U)
+    {
+        printf("FAIL: %u errores\n", (unsigned)failures);
+        return 1;
+    }
+
+    printf("OK\n");
+
+    return 0;
+}